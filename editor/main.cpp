@@ -1,4 +1,5 @@
 #include <engine/app.hpp>
+#include <engine/appState.hpp>
 #include <engine/core/logger.hpp>
 #include <engine/main.hpp>
 #include <memory>
@@ -8,6 +9,12 @@ using namespace WindEngine;
 class WindEditorApp : public App
 {
 public:
+    [[nodiscard]] auto GetConfig() const -> AppConfig override
+    {
+        // The editor is driven by the mouse, so input latency matters more than throughput
+        return { "WindEditor", 1600, 900, kDefaultFramesInFlight, true };
+    }
+
     auto Initialize() -> bool override
     {
         WindDebug( "WindEditorApp::Initialize." );
@@ -19,13 +26,13 @@ public:
         WindDebug( "WindEditorApp::Shutdown." );
     }
 
-    void Update() override
+    void Update( [[maybe_unused]] AppState& state ) override
     {
         SDL_Delay( 3 );
         //        WindTrace( "WindEditorApp::Update." );
     }
 
-    void Render() override
+    void Render( [[maybe_unused]] AppState& state ) override
     {
         SDL_Delay( 3 );
         //        WindTrace( "WindEditorApp::Render." );
@@ -1,8 +1,11 @@
 #ifndef WINDENGINE_APP_HPP
 #define WINDENGINE_APP_HPP
 
+#include "appConfig.h"
+
 namespace WindEngine
 {
+struct AppState;
 
 class App
 {
@@ -14,10 +17,16 @@ public:
     auto operator=( const App& ) -> App& = delete;
     auto operator=( const App&& ) -> App& = delete;
 
+    // Read once by the engine before anything is created, so the frame count and window size come from the app
+    [[nodiscard]] virtual auto GetConfig() const -> AppConfig
+    {
+        return { "WindEngine", 1600, 900 };
+    }
+
     virtual auto Initialize() -> bool = 0;
     virtual void Shutdown() = 0;
-    virtual void Update() = 0;
-    virtual void Render() = 0;
+    virtual void Update( AppState& state ) = 0;
+    virtual void Render( AppState& state ) = 0;
 };
 
 }  // namespace WindEngine
@@ -1,6 +1,7 @@
 #ifndef WINDENGINE_APPSTATE_HPP
 #define WINDENGINE_APPSTATE_HPP
 
+#include "frameAllocator.hpp"
 #include <SDL.h>
 #include <logger.hpp>
 
@@ -13,6 +14,12 @@ struct FrameStats
 {
     U64 totalFrames;
     F64 totalTicks;
+    // Milliseconds from sampling input to the present call returning, the part of the latency the CPU sees
+    U64 presentedFrames;
+    F64 lastInputToPresent;
+    F64 totalInputToPresent;
+    // Milliseconds spent blocked on frame fences
+    F64 totalFenceWait;
 };
 
 struct AppState
@@ -26,13 +33,42 @@ struct AppState
     F64 deltaTime {};
     U64 frameStartTime {};
     U64 lastFrameStartTime {};
+    // SDL performance counter value when input was last polled
+    U64 inputSampleTime {};
     FrameStats frameStats {};
 
+    // Transient memory that lives until the GPU has finished every frame in flight that may read it
+    Core::Memory::FrameAllocator* frameAllocator { nullptr };
+
+    void InputSampled()
+    {
+        inputSampleTime = SDL_GetPerformanceCounter();
+    }
+
+    void FramePresented()
+    {
+        frameStats.lastInputToPresent = GetMillisecondsSince( inputSampleTime );
+        frameStats.totalInputToPresent += frameStats.lastInputToPresent;
+        frameStats.presentedFrames += 1;
+        WindTrace( "Input to Present: {} ms", frameStats.lastInputToPresent );
+    }
+
+    [[nodiscard]] static auto GetMillisecondsSince( U64 counter ) -> F64
+    {
+        return static_cast<F64>( SDL_GetPerformanceCounter() - counter ) * 1000.0 /
+               static_cast<F64>( SDL_GetPerformanceFrequency() );
+    }
+
     void FrameStart()
     {
         frameStartTime = SDL_GetTicks64();
         // Time passed between the previous frame start time and now
         deltaTime = static_cast<F64>( frameStartTime - lastFrameStartTime );
+
+        if ( frameAllocator != nullptr )
+        {
+            frameAllocator->BeginFrame( frameStats.totalFrames );
+        }
     }
 
     void FrameEnd()
@@ -41,6 +77,11 @@ struct AppState
         // Time elapsed during update and render
         const auto timeElapsed = static_cast<F64>( endTime - frameStartTime );
 
+        if ( frameAllocator != nullptr )
+        {
+            frameAllocator->EndFrame();
+        }
+
         if ( isFrameRateFixed )
         {
             const F64 delay = kFrameRate - timeElapsed;
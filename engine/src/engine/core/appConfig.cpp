@@ -1,12 +1,19 @@
 #include "appConfig.h"
+#include "logger.hpp"
+#include <algorithm>
 #include <utility>
 
 namespace WindEngine
 {
 
-AppConfig::AppConfig( std::string appName, U32 width, U32 height )
-  : appName( std::move( appName ) ), width( width ), height( height )
+AppConfig::AppConfig( std::string appName, U32 width, U32 height, U32 framesInFlight, bool lowLatency )
+  : appName( std::move( appName ) ), width( width ), height( height ),
+    framesInFlight( std::clamp( framesInFlight, kMinFramesInFlight, kMaxFramesInFlight ) ), lowLatency( lowLatency )
 {
+    if ( this->framesInFlight != framesInFlight )
+    {
+        WindWarn( "{} frames in flight are not supported, using {}.", framesInFlight, this->framesInFlight );
+    }
 }
 
 }  // namespace WindEngine
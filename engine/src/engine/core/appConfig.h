@@ -7,13 +7,24 @@
 namespace WindEngine
 {
 
+// More frames in flight keep the GPU busier at the cost of input latency
+constexpr U32 kMinFramesInFlight = 1;
+constexpr U32 kMaxFramesInFlight = 4;
+constexpr U32 kDefaultFramesInFlight = 2;
+
 struct AppConfig
 {
     std::string appName {};
     U32 width {};
     U32 height {};
+    // Clamped to [kMinFramesInFlight, kMaxFramesInFlight]
+    U32 framesInFlight { kDefaultFramesInFlight };
+    // Waits on the frame fence before sampling input instead of after Update and Render. Input is fresher, but the app
+    // work no longer overlaps the wait, which lowers throughput.
+    bool lowLatency { false };
 
-    AppConfig( std::string appName, U32 width, U32 height );
+    AppConfig( std::string appName, U32 width, U32 height, U32 framesInFlight = kDefaultFramesInFlight,
+               bool lowLatency = false );
 };
 
 }  // namespace WindEngine
@@ -1,5 +1,7 @@
 #include "allocationManager.hpp"
 #include "../logger.hpp"
+#include "cAllocator.hpp"
+#include "tlsfAllocator.hpp"
 #include <array>
 #include <memory>
 
@@ -10,17 +12,39 @@ constexpr std::array<const char*, kAllocationTypeSize> kTagNames { "ARRAY",
                                                                    "TEXTURE",   "GAME",   "RENDERER",
                                                                    "TRANSFORM", "SCENE",  "DEBUG" };
 
-AllocationManager::AllocationManager() : _allocator( std::make_unique<CAllocator>() )
+auto CreateAllocator( AllocatorBackend backend ) -> std::unique_ptr<Allocator>
 {
+    switch ( backend )
+    {
+    case AllocatorBackend::C_ALLOCATOR:
+        return std::make_unique<CAllocator>();
+    case AllocatorBackend::TLSF:
+        return std::make_unique<TlsfAllocator>();
+    }
+    WindFatal( "Unknown allocator backend" );
 }
 
-auto AllocationManager::Allocate( size_t size, AllocationType type ) -> void*
+AllocationManager::AllocationManager( AllocatorBackend backend, bool useHugePages )
+  : _allocator( CreateAllocator( backend ) )
 {
-    auto* address = _allocator->Allocate( size, false );
+    _allocator->Init();
+    if ( useHugePages )
+    {
+        _upSceneHeap = std::make_unique<TlsfAllocator>( kSceneHeapPoolSize, true );
+        _upSceneHeap->Init();
+    }
+    for ( size_t ind = 0; ind != _resources.size(); ++ind )
+    {
+        _resources[ind] = std::make_unique<TaggedMemoryResource>( *this, static_cast<AllocationType>( ind ) );
+    }
+}
+
+auto AllocationManager::Allocate( size_t size, AllocationType type, size_t alignment ) -> void*
+{
+    auto* address = GetAllocator( type ).Allocate( size, alignment );
     if ( address != nullptr )
     {
-        _stats.tagAllocations[static_cast<size_t>( type )] += size;
-        _stats.totalAllocated += size;
+        _tags[static_cast<size_t>( type )].OnAllocate( size );
     }
     return address;
 }
@@ -29,21 +53,125 @@ void AllocationManager::Free( void* ptr, size_t size, AllocationType type )
 {
     if ( ptr != nullptr )
     {
-        _stats.tagAllocations[static_cast<size_t>( type )] -= size;
-        _stats.totalAllocated -= size;
+        _tags[static_cast<size_t>( type )].OnFree( size );
+    }
+
+    GetAllocator( type ).Free( ptr );
+}
+
+void AllocationManager::RegisterArena( std::string name, const VirtualLinearAllocator& arena )
+{
+    _arenas.push_back( { .name = std::move( name ), .pArena = &arena } );
+}
+
+void AllocationManager::UnregisterArena( const VirtualLinearAllocator& arena )
+{
+    std::erase_if( _arenas, [&arena]( const RegisteredArena& registered ) { return registered.pArena == &arena; } );
+}
+
+auto AllocationManager::GetAllocator( AllocationType type ) -> Allocator&
+{
+    if ( _upSceneHeap != nullptr && ( type == AllocationType::SCENE || type == AllocationType::GAME ) )
+    {
+        return *_upSceneHeap;
     }
+    return *_allocator;
+}
 
-    _allocator->Free( ptr );
+auto AllocationManager::GetResource( AllocationType type ) -> std::pmr::memory_resource*
+{
+    return _resources[static_cast<size_t>( type )].get();
 }
 
-void AllocationManager::PrintStats()
+auto AllocationManager::GetStats() const -> MemoryStats
 {
+    MemoryStats stats { .total = {}, .tags = {} };
+    for ( size_t ind = 0; ind != _tags.size(); ++ind )
+    {
+        const auto tag = _tags[ind].Load();
+        stats.tags[ind] = tag;
+        stats.total.allocatedBytes += tag.allocatedBytes;
+        // Tags peak at different times, so the summed peak is an upper bound of the real one
+        stats.total.peakBytes += tag.peakBytes;
+        stats.total.liveAllocations += tag.liveAllocations;
+        stats.total.totalAllocations += tag.totalAllocations;
+        stats.total.totalFrees += tag.totalFrees;
+    }
+    return stats;
+}
+
+auto AllocationManager::CaptureFrameDelta() -> MemoryStatsDelta
+{
+    const auto makeDelta = []( const MemoryTagStats& current, const MemoryTagStats& last ) {
+        return MemoryTagDelta { .bytes = static_cast<I64>( current.allocatedBytes - last.allocatedBytes ),
+                                .allocations = current.totalAllocations - last.totalAllocations,
+                                .frees = current.totalFrees - last.totalFrees };
+    };
+
+    const auto stats = GetStats();
+    MemoryStatsDelta delta { .total = makeDelta( stats.total, _lastFrameStats.total ), .tags = {} };
+    for ( size_t ind = 0; ind != stats.tags.size(); ++ind )
+    {
+        delta.tags[ind] = makeDelta( stats.tags[ind], _lastFrameStats.tags[ind] );
+    }
+    _lastFrameStats = stats;
+    return delta;
+}
+
+void AllocationManager::PrintStats() const
+{
+    const auto stats = GetStats();
     WindDebug( "[[Memory Statistics]]" );
-    WindDebug( "\tTotal Allocations: {}", _stats.totalAllocated );
-    for ( size_t ind = 0; ind != _stats.tagAllocations.size(); ++ind )
+    WindDebug( "\tTotal Allocations: {} bytes - Peak: {} bytes - Live: {} - Allocated: {} - Freed: {}",
+               stats.total.allocatedBytes, stats.total.peakBytes, stats.total.liveAllocations,
+               stats.total.totalAllocations, stats.total.totalFrees );
+    for ( size_t ind = 0; ind != stats.tags.size(); ++ind )
+    {
+        const auto& tag = stats.tags[ind];
+        WindDebug( "\t{} Allocations: {} bytes - Peak: {} bytes - Live: {} - Allocated: {} - Freed: {}",
+                   kTagNames[ind], tag.allocatedBytes, tag.peakBytes, tag.liveAllocations, tag.totalAllocations,
+                   tag.totalFrees );
+    }
+
+    WindDebug( "[[Memory Arenas]]" );
+    if ( _upSceneHeap != nullptr )
+    {
+        WindDebug( "\tScene Heap: {} pools - {} on huge pages", _upSceneHeap->GetPoolCount(),
+                   _upSceneHeap->GetHugePagePoolCount() );
+    }
+    for ( const auto& [name, pArena] : _arenas )
     {
-        WindDebug( "\t{} Allocations: {}", kTagNames[ind], _stats.tagAllocations[ind] );
+        WindDebug( "\t{}: {} bytes reserved - {} bytes committed - {}", name, pArena->GetSize(),
+                   pArena->GetCommitted(), GetPageBackingName( pArena->GetPageBacking() ) );
     }
 }
 
+void AllocationManager::TagCounters::OnAllocate( size_t size )
+{
+    const auto current = allocatedBytes.fetch_add( size, std::memory_order_relaxed ) + size;
+    liveAllocations.fetch_add( 1, std::memory_order_relaxed );
+    totalAllocations.fetch_add( 1, std::memory_order_relaxed );
+
+    auto peak = peakBytes.load( std::memory_order_relaxed );
+    while ( current > peak && !peakBytes.compare_exchange_weak( peak, current, std::memory_order_relaxed ) )
+    {
+    }
+}
+
+void AllocationManager::TagCounters::OnFree( size_t size )
+{
+    allocatedBytes.fetch_sub( size, std::memory_order_relaxed );
+    liveAllocations.fetch_sub( 1, std::memory_order_relaxed );
+    totalFrees.fetch_add( 1, std::memory_order_relaxed );
+}
+
+auto AllocationManager::TagCounters::Load() const -> MemoryTagStats
+{
+    return { .allocatedBytes = allocatedBytes.load( std::memory_order_relaxed ),
+             .peakBytes = peakBytes.load( std::memory_order_relaxed ),
+             .liveAllocations = liveAllocations.load( std::memory_order_relaxed ),
+             .totalAllocations = totalAllocations.load( std::memory_order_relaxed ),
+             .totalFrees = totalFrees.load( std::memory_order_relaxed ) };
+}
+
 }  // namespace WindEngine::Core::Memory
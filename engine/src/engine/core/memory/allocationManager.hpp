@@ -1,10 +1,18 @@
 #ifndef WINDENGINE_ALLOCATIONMANAGER_HPP
 #define WINDENGINE_ALLOCATIONMANAGER_HPP
 
-#include "cAllocator.hpp"
+#include "allocator.hpp"
 #include "defines.hpp"
+#include "memoryResource.hpp"
+#include "memoryUtils.hpp"
+#include "tlsfAllocator.hpp"
+#include "virtualLinearAllocator.hpp"
 #include <array>
+#include <atomic>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace WindEngine::Core::Memory
 {
@@ -24,24 +32,123 @@ enum class AllocationType
 
 constexpr size_t kAllocationTypeSize = static_cast<size_t>( AllocationType::DEBUG ) + 1;
 
+enum class AllocatorBackend
+{
+    C_ALLOCATOR,
+    TLSF
+};
+
+constexpr auto kDefaultAllocatorBackend = AllocatorBackend::TLSF;
+
+// SCENE and GAME data goes to a separate heap mapped on huge pages, it is large and walked every frame
+constexpr size_t kSceneHeapPoolSize = 256 * 1024 * 1024;
+
+struct MemoryTagStats
+{
+    U64 allocatedBytes;
+    U64 peakBytes;
+    U64 liveAllocations;
+    U64 totalAllocations;
+    U64 totalFrees;
+};
+
+// Plain copy of the counters, safe to keep around and compare
 struct MemoryStats
 {
-    U64 totalAllocated;
-    std::array<U64, kAllocationTypeSize> tagAllocations;
+    MemoryTagStats total;
+    std::array<MemoryTagStats, kAllocationTypeSize> tags;
+};
+
+struct MemoryTagDelta
+{
+    I64 bytes;
+    U64 allocations;
+    U64 frees;
+};
+
+struct MemoryStatsDelta
+{
+    MemoryTagDelta total;
+    std::array<MemoryTagDelta, kAllocationTypeSize> tags;
 };
 
 class AllocationManager
 {
 public:
-    AllocationManager();
-    auto Allocate( size_t size, AllocationType type ) -> void*;
+    explicit AllocationManager( AllocatorBackend backend = kDefaultAllocatorBackend, bool useHugePages = true );
+    auto Allocate( size_t size, AllocationType type, size_t alignment = kDefaultAlignment ) -> void*;
     void Free( void* ptr, size_t size, AllocationType type );
 
-    void PrintStats();
+    template <typename T, typename... Args> auto New( AllocationType type, Args&&... args ) -> T*
+    {
+        auto* ptr = Allocate( sizeof( T ), type, alignof( T ) );
+        if ( ptr == nullptr )
+        {
+            return nullptr;
+        }
+        try
+        {
+            return new ( ptr ) T( std::forward<Args>( args )... );
+        }
+        catch ( ... )
+        {
+            Free( ptr, sizeof( T ), type );
+            throw;
+        }
+    }
+
+    template <typename T> void Delete( T* ptr, AllocationType type )
+    {
+        if ( ptr != nullptr )
+        {
+            ptr->~T();
+            Free( ptr, sizeof( T ), type );
+        }
+    }
+
+    // pmr resource that allocates through this manager under the given tag
+    [[nodiscard]] auto GetResource( AllocationType type ) -> std::pmr::memory_resource*;
+
+    // Registered arenas are listed with their page backing in PrintStats. The arena has to outlive the registration.
+    void RegisterArena( std::string name, const VirtualLinearAllocator& arena );
+    void UnregisterArena( const VirtualLinearAllocator& arena );
+
+    [[nodiscard]] auto GetStats() const -> MemoryStats;
+    // Difference since the previous call, meant to be called once per frame from the main thread
+    auto CaptureFrameDelta() -> MemoryStatsDelta;
+
+    void PrintStats() const;
 
 private:
-    std::unique_ptr<CAllocator> _allocator { nullptr };
-    MemoryStats _stats {};
+    // Counters are updated with relaxed atomics from any thread. Each tag sits on its own cache line so threads
+    // allocating under different tags do not contend, totals are summed from the tags when read.
+    struct alignas( kCacheLineSize ) TagCounters
+    {
+        std::atomic<U64> allocatedBytes { 0 };
+        std::atomic<U64> peakBytes { 0 };
+        std::atomic<U64> liveAllocations { 0 };
+        std::atomic<U64> totalAllocations { 0 };
+        std::atomic<U64> totalFrees { 0 };
+
+        void OnAllocate( size_t size );
+        void OnFree( size_t size );
+        [[nodiscard]] auto Load() const -> MemoryTagStats;
+    };
+
+    struct RegisteredArena
+    {
+        std::string name;
+        const VirtualLinearAllocator* pArena;
+    };
+
+    [[nodiscard]] auto GetAllocator( AllocationType type ) -> Allocator&;
+
+    std::unique_ptr<Allocator> _allocator { nullptr };
+    std::unique_ptr<TlsfAllocator> _upSceneHeap { nullptr };
+    std::vector<RegisteredArena> _arenas;
+    std::array<TagCounters, kAllocationTypeSize> _tags {};
+    std::array<std::unique_ptr<TaggedMemoryResource>, kAllocationTypeSize> _resources {};
+    MemoryStats _lastFrameStats {};
 };
 
 }  // namespace WindEngine::Core::Memory
@@ -2,11 +2,16 @@
 #define WINDENGINE_ALLOCATOR_HPP
 
 #include "defines.hpp"
+#include <cstddef>
 #include <memory>
+#include <new>
+#include <utility>
 
 namespace WindEngine::Core::Memory
 {
 
+constexpr size_t kDefaultAlignment = alignof( std::max_align_t );
+
 class Allocator
 {
 public:
@@ -28,9 +33,51 @@ public:
     {
     }
 
-    virtual auto Allocate( size_t size, bool shouldAlign ) -> void* = 0;
+    // Alignment has to be a power of two
+    virtual auto Allocate( size_t size, size_t alignment ) -> void* = 0;
     virtual void Free( void* ptr ) = 0;
 
+    template <typename T, typename... Args> auto New( Args&&... args ) -> T*
+    {
+        auto* ptr = Allocate( sizeof( T ), alignof( T ) );
+        if ( ptr == nullptr )
+        {
+            return nullptr;
+        }
+        try
+        {
+            return new ( ptr ) T( std::forward<Args>( args )... );
+        }
+        catch ( ... )
+        {
+            if ( CanFree() )
+            {
+                Free( ptr );
+            }
+            throw;
+        }
+    }
+
+    // Allocators that can not free only run the destructor, the memory goes back with the next reset
+    template <typename T> void Delete( T* ptr )
+    {
+        if ( ptr == nullptr )
+        {
+            return;
+        }
+        ptr->~T();
+        if ( CanFree() )
+        {
+            Free( ptr );
+        }
+    }
+
+    // False for allocators that only release memory in bulk
+    [[nodiscard]] virtual auto CanFree() const -> bool
+    {
+        return true;
+    }
+
     [[nodiscard]] auto GetSize() const -> size_t
     {
         return _size;
@@ -1,4 +1,6 @@
 #include "cAllocator.hpp"
+#include "memoryUtils.hpp"
+#include <algorithm>
 
 namespace WindEngine::Core::Memory
 {
@@ -7,14 +9,14 @@ CAllocator::CAllocator() : Allocator( 0 )
 {
 }
 
-auto CAllocator::Allocate( size_t size, [[maybe_unused]] bool shouldAlign ) -> void*
+auto CAllocator::Allocate( size_t size, size_t alignment ) -> void*
 {
-    return std::malloc( size );
+    return AlignedAlloc( size, std::max( alignment, kDefaultAlignment ) );
 }
 
 void WindEngine::Core::Memory::CAllocator::Free( void* ptr )
 {
-    std::free( ptr );
+    AlignedFree( ptr );
 }
 
 }  // namespace WindEngine::Core::Memory
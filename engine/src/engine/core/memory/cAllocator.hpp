@@ -10,7 +10,7 @@ class CAllocator : public Allocator
 {
 public:
     CAllocator();
-    auto Allocate( size_t size, bool shouldAlign ) -> void* override;
+    auto Allocate( size_t size, size_t alignment ) -> void* override;
     void Free( void* ptr ) override;
 };
 
@@ -0,0 +1,61 @@
+#include "frameAllocator.hpp"
+#include "core/assert.hpp"
+#include "core/logger.hpp"
+#include <algorithm>
+
+namespace WindEngine::Core::Memory
+{
+
+FrameAllocator::FrameAllocator( size_t arenaSize, U32 frameCount, const VirtualArenaInfo& arenaInfo )
+  : Allocator( arenaSize )
+{
+    WindAssert( frameCount > 0, "FrameAllocator needs at least one arena." );
+    _arenas.reserve( frameCount );
+    for ( U32 ind = 0; ind < frameCount; ++ind )
+    {
+        _arenas.push_back( std::make_unique<VirtualLinearAllocator>( arenaSize, arenaInfo ) );
+    }
+}
+
+void FrameAllocator::Init()
+{
+    for ( auto& arena : _arenas )
+    {
+        arena->Init();
+    }
+    _currentArena = 0;
+    _frameUsage = 0;
+    _highWaterMark = 0;
+    WindDebug( "FrameAllocator::Init with {} arenas reserving {} bytes each.", _arenas.size(), GetSize() );
+}
+
+auto FrameAllocator::Allocate( size_t size, size_t alignment ) -> void*
+{
+    auto* address = _arenas[_currentArena]->Allocate( size, alignment );
+    if ( address == nullptr )
+    {
+        WindError( "FrameAllocator arena {} is out of memory. Requested {} bytes.", _currentArena, size );
+    }
+    return address;
+}
+
+void FrameAllocator::Free( [[maybe_unused]] void* ptr )
+{
+    WindAssert( false, "Frame allocations are released when the frame slot is reused." );
+}
+
+void FrameAllocator::BeginFrame( U64 frameNumber )
+{
+    _currentArena = static_cast<size_t>( frameNumber % _arenas.size() );
+    _arenas[_currentArena]->Reset();
+}
+
+void FrameAllocator::EndFrame()
+{
+    _frameUsage = _arenas[_currentArena]->GetUsed();
+    _highWaterMark = std::max( _highWaterMark, _frameUsage );
+    WindTrace( "Frame arena {} used {} bytes - Committed: {} bytes - High-water mark: {} bytes", _currentArena,
+               _frameUsage, _arenas[_currentArena]->GetCommitted(), _highWaterMark );
+}
+
+}  // namespace WindEngine::Core::Memory
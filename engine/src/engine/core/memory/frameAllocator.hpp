@@ -0,0 +1,82 @@
+#ifndef WINDENGINE_FRAMEALLOCATOR_HPP
+#define WINDENGINE_FRAMEALLOCATOR_HPP
+
+#include "allocator.hpp"
+#include "memoryResource.hpp"
+#include "virtualLinearAllocator.hpp"
+#include <memory>
+#include <vector>
+
+namespace WindEngine::Core::Memory
+{
+
+// Address space reserved per arena, only the pages a frame actually touches are committed
+constexpr size_t kDefaultFrameArenaSize = 256 * 1024 * 1024;
+
+// Linear arenas used round robin by CPU frame number. BeginFrame resets the arena of the frame, which is only safe once
+// the GPU has finished the frame that used it last, so the owner sizes the arena count to how far the CPU can run
+// ahead of the GPU.
+class FrameAllocator : public Allocator
+{
+public:
+    FrameAllocator( size_t arenaSize, U32 frameCount, const VirtualArenaInfo& arenaInfo = {} );
+    ~FrameAllocator() override = default;
+    FrameAllocator( const FrameAllocator& ) = delete;
+    FrameAllocator( const FrameAllocator&& ) = delete;
+    auto operator=( const FrameAllocator& ) -> FrameAllocator& = delete;
+    auto operator=( const FrameAllocator&& ) -> FrameAllocator& = delete;
+
+    void Init() override;
+    auto Allocate( size_t size, size_t alignment ) -> void* override;
+    void Free( void* ptr ) override;
+
+    [[nodiscard]] auto CanFree() const -> bool override
+    {
+        return false;
+    }
+
+    void BeginFrame( U64 frameNumber );
+    void EndFrame();
+
+    template <typename T> auto AllocateArray( size_t count ) -> T*
+    {
+        return static_cast<T*>( Allocate( sizeof( T ) * count, alignof( T ) ) );
+    }
+
+    // pmr view of the current frame arena, for containers that only live for the frame
+    [[nodiscard]] auto GetResource() -> std::pmr::memory_resource*
+    {
+        return &_resource;
+    }
+
+    [[nodiscard]] auto GetArenaCount() const -> size_t
+    {
+        return _arenas.size();
+    }
+
+    [[nodiscard]] auto GetArena( size_t index ) const -> const VirtualLinearAllocator&
+    {
+        return *_arenas[index];
+    }
+
+    [[nodiscard]] auto GetFrameUsage() const -> size_t
+    {
+        return _frameUsage;
+    }
+
+    [[nodiscard]] auto GetHighWaterMark() const -> size_t
+    {
+        return _highWaterMark;
+    }
+
+private:
+    std::vector<std::unique_ptr<VirtualLinearAllocator>> _arenas;
+    AllocatorResource _resource { *this };
+    size_t _currentArena { 0 };
+    size_t _frameUsage { 0 };
+    size_t _highWaterMark { 0 };
+};
+
+}  // namespace WindEngine::Core::Memory
+
+#endif  // WINDENGINE_FRAMEALLOCATOR_HPP
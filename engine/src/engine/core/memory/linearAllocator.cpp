@@ -1,13 +1,12 @@
 #include "linearAllocator.hpp"
 #include "core/assert.hpp"
 #include "core/logger.hpp"
+#include "memoryUtils.hpp"
 #include <spdlog/fmt/fmt.h>
 
 namespace WindEngine::Core::Memory
 {
 
-static constexpr size_t kAlignment = sizeof( void* );
-
 LinearAllocator::LinearAllocator( size_t size ) : Allocator( size )
 {
 }
@@ -29,13 +28,11 @@ void LinearAllocator::Init()
     WindDebug( "LinearAllocator::Init" );
 }
 
-auto LinearAllocator::Allocate( size_t size, bool shouldAlign ) -> void*
+auto LinearAllocator::Allocate( size_t size, size_t alignment ) -> void*
 {
-    size_t padding = 0;
-    if ( shouldAlign && _offset % kAlignment != 0 )
-    {
-        padding = kAlignment - ( _offset % kAlignment );
-    }
+    WindAssert( IsPowerOfTwo( alignment ), "LinearAllocator alignment has to be a power of two." );
+    const auto address = reinterpret_cast<uintptr_t>( _pStart ) + _offset;
+    const auto padding = AlignUp( address, alignment ) - address;
 
     if ( _offset + size + padding > GetSize() )
     {
@@ -45,8 +42,8 @@ auto LinearAllocator::Allocate( size_t size, bool shouldAlign ) -> void*
     std::byte* pAddress = _pStart + _offset + padding;
     _offset += size + padding;
 
-    WindDebug( "LinearAllocator::Allocate" );
-    WindDebug( "Current Address: {} - Padding: {}", fmt::ptr( pAddress ), padding );
+    WindTrace( "LinearAllocator::Allocate" );
+    WindTrace( "Current Address: {} - Padding: {}", fmt::ptr( pAddress ), padding );
 
     return pAddress;
 }
@@ -58,7 +55,7 @@ void LinearAllocator::Free( [[maybe_unused]] void* ptr )
 
 void LinearAllocator::Reset()
 {
-    WindDebug( "LinearAllocator::Reset" );
+    WindTrace( "LinearAllocator::Reset" );
     _offset = 0;
 }
 
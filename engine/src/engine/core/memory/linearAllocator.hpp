@@ -17,10 +17,20 @@ public:
     auto operator=( const LinearAllocator&& ) -> LinearAllocator& = delete;
 
     void Init() override;
-    auto Allocate( size_t size, bool shouldAlign ) -> void* override;
+    auto Allocate( size_t size, size_t alignment ) -> void* override;
     void Free( void* ptr ) override;
+
+    [[nodiscard]] auto CanFree() const -> bool override
+    {
+        return false;
+    }
     void Reset();
 
+    [[nodiscard]] auto GetUsed() const -> size_t
+    {
+        return _offset;
+    }
+
 private:
     std::byte* _pStart { nullptr };
     size_t _offset { 0 };
@@ -0,0 +1,155 @@
+#include "mappedFile.hpp"
+#include "core/logger.hpp"
+#include <utility>
+
+#if defined( _WIN32 )
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace WindEngine::Core::Memory
+{
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+MappedFile::MappedFile( MappedFile&& other ) noexcept
+  : _ptr( std::exchange( other._ptr, nullptr ) ), _size( std::exchange( other._size, 0 ) ),
+    _isOpen( std::exchange( other._isOpen, false ) )
+#if defined( _WIN32 )
+    ,
+    _mappingHandle( std::exchange( other._mappingHandle, nullptr ) )
+#endif
+{
+}
+
+auto MappedFile::operator=( MappedFile&& other ) noexcept -> MappedFile&
+{
+    if ( this != &other )
+    {
+        Close();
+        _ptr = std::exchange( other._ptr, nullptr );
+        _size = std::exchange( other._size, 0 );
+        _isOpen = std::exchange( other._isOpen, false );
+#if defined( _WIN32 )
+        _mappingHandle = std::exchange( other._mappingHandle, nullptr );
+#endif
+    }
+    return *this;
+}
+
+#if defined( _WIN32 )
+auto MappedFile::Open( const std::filesystem::path& path, [[maybe_unused]] const MappedFileInfo& info ) -> bool
+{
+    Close();
+    auto* fileHandle = CreateFileW( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    info.sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL, nullptr );
+    if ( fileHandle == INVALID_HANDLE_VALUE )
+    {
+        WindError( "Failed to open {}.", path.string() );
+        return false;
+    }
+
+    LARGE_INTEGER fileSize {};
+    GetFileSizeEx( fileHandle, &fileSize );
+    _size = static_cast<size_t>( fileSize.QuadPart );
+    if ( _size != 0 )
+    {
+        // The mapping keeps its own reference to the file
+        _mappingHandle = CreateFileMappingW( fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        _ptr = _mappingHandle != nullptr ? MapViewOfFile( _mappingHandle, FILE_MAP_READ, 0, 0, 0 ) : nullptr;
+    }
+    CloseHandle( fileHandle );
+    if ( _size != 0 && _ptr == nullptr )
+    {
+        WindError( "Failed to map {}.", path.string() );
+        Close();
+        return false;
+    }
+    _isOpen = true;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if ( _ptr != nullptr )
+    {
+        UnmapViewOfFile( _ptr );
+    }
+    if ( _mappingHandle != nullptr )
+    {
+        CloseHandle( _mappingHandle );
+    }
+    _ptr = nullptr;
+    _mappingHandle = nullptr;
+    _size = 0;
+    _isOpen = false;
+}
+#else
+auto MappedFile::Open( const std::filesystem::path& path, const MappedFileInfo& info ) -> bool
+{
+    Close();
+    const auto fileDescriptor = open( path.c_str(), O_RDONLY | O_CLOEXEC );
+    if ( fileDescriptor < 0 )
+    {
+        WindError( "Failed to open {}.", path.string() );
+        return false;
+    }
+
+    struct stat fileStat {};
+    if ( fstat( fileDescriptor, &fileStat ) != 0 )
+    {
+        WindError( "Failed to stat {}.", path.string() );
+        close( fileDescriptor );
+        return false;
+    }
+
+    _size = static_cast<size_t>( fileStat.st_size );
+    if ( _size != 0 )
+    {
+        auto flags = MAP_PRIVATE;
+#if defined( MAP_POPULATE )
+        if ( info.populate )
+        {
+            flags |= MAP_POPULATE;
+        }
+#endif
+        auto* ptr = mmap( nullptr, _size, PROT_READ, flags, fileDescriptor, 0 );
+        if ( ptr == MAP_FAILED )
+        {
+            WindError( "Failed to map {}.", path.string() );
+            close( fileDescriptor );
+            _size = 0;
+            return false;
+        }
+        _ptr = ptr;
+        if ( info.sequential )
+        {
+            madvise( _ptr, _size, MADV_SEQUENTIAL );
+        }
+    }
+    // The mapping keeps its own reference to the file
+    close( fileDescriptor );
+    _isOpen = true;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if ( _ptr != nullptr )
+    {
+        munmap( _ptr, _size );
+    }
+    _ptr = nullptr;
+    _size = 0;
+    _isOpen = false;
+}
+#endif
+
+}  // namespace WindEngine::Core::Memory
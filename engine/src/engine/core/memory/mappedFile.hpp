@@ -0,0 +1,62 @@
+#ifndef WINDENGINE_MAPPEDFILE_HPP
+#define WINDENGINE_MAPPEDFILE_HPP
+
+#include "defines.hpp"
+#include <filesystem>
+#include <span>
+
+namespace WindEngine::Core::Memory
+{
+
+struct MappedFileInfo
+{
+    // Fault every page in while mapping (MAP_POPULATE), for files that are read whole right away such as shaders
+    bool populate { false };
+    // Hint that the file is read front to back so the kernel reads ahead more aggressively
+    bool sequential { false };
+};
+
+// Read-only view of a whole file mapped into the address space. Pages are read from the page cache on first touch
+// and nothing is copied into the heap, the span stays valid as long as the MappedFile lives. The mapping is page
+// aligned, so the data can be reinterpreted as any type with a smaller alignment.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile( MappedFile&& other ) noexcept;
+    auto operator=( const MappedFile& ) -> MappedFile& = delete;
+    auto operator=( MappedFile&& other ) noexcept -> MappedFile&;
+
+    // Logs and returns false if the file cannot be opened or mapped. An empty file opens to an empty span.
+    [[nodiscard]] auto Open( const std::filesystem::path& path, const MappedFileInfo& info = {} ) -> bool;
+    void Close();
+
+    [[nodiscard]] auto IsOpen() const -> bool
+    {
+        return _isOpen;
+    }
+
+    [[nodiscard]] auto GetData() const -> std::span<const std::byte>
+    {
+        return { static_cast<const std::byte*>( _ptr ), _size };
+    }
+
+    [[nodiscard]] auto GetSize() const -> size_t
+    {
+        return _size;
+    }
+
+private:
+    void* _ptr { nullptr };
+    size_t _size {};
+    bool _isOpen { false };
+#if defined( _WIN32 )
+    void* _mappingHandle { nullptr };
+#endif
+};
+
+}  // namespace WindEngine::Core::Memory
+
+#endif  // WINDENGINE_MAPPEDFILE_HPP
@@ -0,0 +1,61 @@
+#include "memoryResource.hpp"
+#include "allocationManager.hpp"
+#include "core/logger.hpp"
+#include <new>
+
+namespace WindEngine::Core::Memory
+{
+
+AllocatorResource::AllocatorResource( Allocator& allocator ) : _allocator( allocator )
+{
+}
+
+auto AllocatorResource::do_allocate( size_t bytes, size_t alignment ) -> void*
+{
+    auto* ptr = _allocator.Allocate( bytes, alignment );
+    if ( ptr == nullptr )
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void AllocatorResource::do_deallocate( void* ptr, [[maybe_unused]] size_t bytes, [[maybe_unused]] size_t alignment )
+{
+    if ( _allocator.CanFree() )
+    {
+        _allocator.Free( ptr );
+    }
+}
+
+auto AllocatorResource::do_is_equal( const std::pmr::memory_resource& other ) const noexcept -> bool
+{
+    return this == &other;
+}
+
+TaggedMemoryResource::TaggedMemoryResource( AllocationManager& manager, AllocationType type )
+  : _manager( manager ), _type( type )
+{
+}
+
+auto TaggedMemoryResource::do_allocate( size_t bytes, size_t alignment ) -> void*
+{
+    auto* ptr = _manager.Allocate( bytes, _type, alignment );
+    if ( ptr == nullptr )
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void TaggedMemoryResource::do_deallocate( void* ptr, size_t bytes, [[maybe_unused]] size_t alignment )
+{
+    _manager.Free( ptr, bytes, _type );
+}
+
+auto TaggedMemoryResource::do_is_equal( const std::pmr::memory_resource& other ) const noexcept -> bool
+{
+    return this == &other;
+}
+
+}  // namespace WindEngine::Core::Memory
@@ -0,0 +1,45 @@
+#ifndef WINDENGINE_MEMORYRESOURCE_HPP
+#define WINDENGINE_MEMORYRESOURCE_HPP
+
+#include "allocator.hpp"
+#include <memory_resource>
+
+namespace WindEngine::Core::Memory
+{
+
+class AllocationManager;
+enum class AllocationType;
+
+// Lets standard pmr containers allocate from an engine allocator. Deallocation is ignored for allocators that only
+// release in bulk (linear, frame and stack allocators).
+class AllocatorResource final : public std::pmr::memory_resource
+{
+public:
+    explicit AllocatorResource( Allocator& allocator );
+
+private:
+    auto do_allocate( size_t bytes, size_t alignment ) -> void* override;
+    void do_deallocate( void* ptr, size_t bytes, size_t alignment ) override;
+    [[nodiscard]] auto do_is_equal( const std::pmr::memory_resource& other ) const noexcept -> bool override;
+
+    Allocator& _allocator;
+};
+
+// Allocates through the AllocationManager so container memory shows up under the given tag
+class TaggedMemoryResource final : public std::pmr::memory_resource
+{
+public:
+    TaggedMemoryResource( AllocationManager& manager, AllocationType type );
+
+private:
+    auto do_allocate( size_t bytes, size_t alignment ) -> void* override;
+    void do_deallocate( void* ptr, size_t bytes, size_t alignment ) override;
+    [[nodiscard]] auto do_is_equal( const std::pmr::memory_resource& other ) const noexcept -> bool override;
+
+    AllocationManager& _manager;
+    AllocationType _type;
+};
+
+}  // namespace WindEngine::Core::Memory
+
+#endif  // WINDENGINE_MEMORYRESOURCE_HPP
@@ -0,0 +1,54 @@
+#ifndef WINDENGINE_MEMORYUTILS_HPP
+#define WINDENGINE_MEMORYUTILS_HPP
+
+#include "defines.hpp"
+#include <cstdint>
+#include <cstdlib>
+
+namespace WindEngine::Core::Memory
+{
+
+constexpr size_t kCacheLineSize = 64;
+
+constexpr auto IsPowerOfTwo( size_t value ) -> bool
+{
+    return value != 0 && ( value & ( value - 1 ) ) == 0;
+}
+
+constexpr auto AlignUp( size_t value, size_t alignment ) -> size_t
+{
+    return ( value + alignment - 1 ) & ~( alignment - 1 );
+}
+
+inline auto AlignUp( void* ptr, size_t alignment ) -> void*
+{
+    return reinterpret_cast<void*>( AlignUp( reinterpret_cast<uintptr_t>( ptr ), alignment ) );
+}
+
+inline auto IsAligned( const void* ptr, size_t alignment ) -> bool
+{
+    return ( reinterpret_cast<uintptr_t>( ptr ) & ( alignment - 1 ) ) == 0;
+}
+
+// Alignment has to be a power of two. Memory has to be released with AlignedFree.
+inline auto AlignedAlloc( size_t size, size_t alignment ) -> void*
+{
+#if defined( _MSC_VER )
+    return _aligned_malloc( size, alignment );
+#else
+    return std::aligned_alloc( alignment, AlignUp( size, alignment ) );
+#endif
+}
+
+inline void AlignedFree( void* ptr )
+{
+#if defined( _MSC_VER )
+    _aligned_free( ptr );
+#else
+    std::free( ptr );
+#endif
+}
+
+}  // namespace WindEngine::Core::Memory
+
+#endif  // WINDENGINE_MEMORYUTILS_HPP
@@ -0,0 +1,114 @@
+#include "poolAllocator.hpp"
+#include "core/assert.hpp"
+#include "core/logger.hpp"
+#include "memoryUtils.hpp"
+#include <algorithm>
+
+namespace WindEngine::Core::Memory
+{
+
+static constexpr size_t kMaxSlotAlignment = 64;
+
+PoolAllocator::PoolAllocator( size_t slotSize )
+  : Allocator( 0 ), _slotSize( AlignUp( std::max( slotSize, sizeof( FreeSlot ) ), sizeof( void* ) ) )
+{
+    // Slots are aligned to the largest power of two that divides the slot size, up to a cache line
+    _slotAlignment = std::min( _slotSize & ( ~_slotSize + 1 ), kMaxSlotAlignment );
+    _firstSlotOffset = AlignUp( sizeof( BlockHeader ), _slotAlignment );
+    WindAssert( _firstSlotOffset + _slotSize <= kPoolBlockSize, "Pool slot size does not fit in a pool block." );
+}
+
+PoolAllocator::~PoolAllocator()
+{
+    ReleaseBlocks();
+}
+
+void PoolAllocator::Init()
+{
+    ReleaseBlocks();
+    AllocateBlock();
+    WindDebug( "PoolAllocator::Init with {} byte slots.", _slotSize );
+}
+
+auto PoolAllocator::Allocate( size_t size, size_t alignment ) -> void*
+{
+    if ( size > _slotSize || alignment > _slotAlignment )
+    {
+        WindError( "PoolAllocator can not allocate {} bytes aligned to {} from {} byte slots aligned to {}.", size,
+                   alignment, _slotSize, _slotAlignment );
+        return nullptr;
+    }
+
+    if ( _pFreeList == nullptr && !AllocateBlock() )
+    {
+        return nullptr;
+    }
+
+    auto* pSlot = _pFreeList;
+    _pFreeList = pSlot->next;
+    ++_usedSlots;
+    return pSlot;
+}
+
+void PoolAllocator::Free( void* ptr )
+{
+    if ( ptr == nullptr )
+    {
+        return;
+    }
+    WindAssert( GetOwner( ptr ) == this, "Pointer was not allocated from this pool." );
+
+    auto* pSlot = static_cast<FreeSlot*>( ptr );
+    pSlot->next = _pFreeList;
+    _pFreeList = pSlot;
+    --_usedSlots;
+}
+
+auto PoolAllocator::GetOwner( void* ptr ) -> PoolAllocator*
+{
+    const auto blockAddress = reinterpret_cast<uintptr_t>( ptr ) & ~( kPoolBlockSize - 1 );
+    return reinterpret_cast<BlockHeader*>( blockAddress )->owner;
+}
+
+auto PoolAllocator::AllocateBlock() -> bool
+{
+    auto* pBlock = static_cast<std::byte*>( AlignedAlloc( kPoolBlockSize, kPoolBlockSize ) );
+    if ( pBlock == nullptr )
+    {
+        WindError( "PoolAllocator failed to allocate a new block." );
+        return false;
+    }
+
+    auto* pHeader = reinterpret_cast<BlockHeader*>( pBlock );
+    pHeader->owner = this;
+    pHeader->next = _pBlocks;
+    _pBlocks = pHeader;
+    ++_blockCount;
+
+    // Thread the new slots in address order so consecutive allocations are adjacent in memory
+    const auto slotCount = ( kPoolBlockSize - _firstSlotOffset ) / _slotSize;
+    for ( size_t ind = slotCount; ind-- > 0; )
+    {
+        auto* pSlot = reinterpret_cast<FreeSlot*>( pBlock + _firstSlotOffset + ind * _slotSize );
+        pSlot->next = _pFreeList;
+        _pFreeList = pSlot;
+    }
+
+    WindTrace( "PoolAllocator added block {} with {} slots of {} bytes.", _blockCount, slotCount, _slotSize );
+    return true;
+}
+
+void PoolAllocator::ReleaseBlocks()
+{
+    while ( _pBlocks != nullptr )
+    {
+        auto* pNext = _pBlocks->next;
+        AlignedFree( _pBlocks );
+        _pBlocks = pNext;
+    }
+    _pFreeList = nullptr;
+    _blockCount = 0;
+    _usedSlots = 0;
+}
+
+}  // namespace WindEngine::Core::Memory
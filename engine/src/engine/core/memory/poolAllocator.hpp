@@ -0,0 +1,74 @@
+#ifndef WINDENGINE_POOLALLOCATOR_HPP
+#define WINDENGINE_POOLALLOCATOR_HPP
+
+#include "allocator.hpp"
+
+namespace WindEngine::Core::Memory
+{
+
+// Blocks are aligned to their size so the owning pool of any slot can be found from its address.
+constexpr size_t kPoolBlockSize = 64 * 1024;
+
+class PoolAllocator : public Allocator
+{
+public:
+    explicit PoolAllocator( size_t slotSize );
+    ~PoolAllocator() override;
+    PoolAllocator( const PoolAllocator& ) = delete;
+    PoolAllocator( const PoolAllocator&& ) = delete;
+    auto operator=( const PoolAllocator& ) -> PoolAllocator& = delete;
+    auto operator=( const PoolAllocator&& ) -> PoolAllocator& = delete;
+
+    void Init() override;
+    auto Allocate( size_t size, size_t alignment ) -> void* override;
+    void Free( void* ptr ) override;
+
+    [[nodiscard]] auto GetSlotSize() const -> size_t
+    {
+        return _slotSize;
+    }
+
+    [[nodiscard]] auto GetSlotAlignment() const -> size_t
+    {
+        return _slotAlignment;
+    }
+
+    [[nodiscard]] auto GetBlockCount() const -> size_t
+    {
+        return _blockCount;
+    }
+
+    [[nodiscard]] auto GetUsedSlots() const -> size_t
+    {
+        return _usedSlots;
+    }
+
+    [[nodiscard]] static auto GetOwner( void* ptr ) -> PoolAllocator*;
+
+private:
+    struct BlockHeader
+    {
+        PoolAllocator* owner;
+        BlockHeader* next;
+    };
+
+    struct FreeSlot
+    {
+        FreeSlot* next;
+    };
+
+    auto AllocateBlock() -> bool;
+    void ReleaseBlocks();
+
+    size_t _slotSize;
+    size_t _slotAlignment;
+    size_t _firstSlotOffset;
+    BlockHeader* _pBlocks { nullptr };
+    FreeSlot* _pFreeList { nullptr };
+    size_t _blockCount { 0 };
+    size_t _usedSlots { 0 };
+};
+
+}  // namespace WindEngine::Core::Memory
+
+#endif  // WINDENGINE_POOLALLOCATOR_HPP
@@ -0,0 +1,62 @@
+#include "sizeClassAllocator.hpp"
+#include "core/assert.hpp"
+#include "core/logger.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace WindEngine::Core::Memory
+{
+
+static_assert( kMinSizeClass << ( kSizeClassCount - 1 ) == kMaxSizeClass );
+
+SizeClassAllocator::SizeClassAllocator() : Allocator( 0 )
+{
+    for ( size_t ind = 0; ind < _pools.size(); ++ind )
+    {
+        _pools[ind] = std::make_unique<PoolAllocator>( kMinSizeClass << ind );
+    }
+}
+
+void SizeClassAllocator::Init()
+{
+    for ( auto& pool : _pools )
+    {
+        pool->Init();
+    }
+}
+
+auto SizeClassAllocator::Allocate( size_t size, size_t alignment ) -> void*
+{
+    // Slots of a power of two class are aligned to the class size, so a larger alignment picks a larger class
+    auto* pPool = GetPool( std::max( size, alignment ) );
+    if ( pPool == nullptr || pPool->GetSlotAlignment() < alignment )
+    {
+        return nullptr;
+    }
+    return pPool->Allocate( size, alignment );
+}
+
+void SizeClassAllocator::Free( void* ptr )
+{
+    if ( ptr == nullptr )
+    {
+        return;
+    }
+    auto* pOwner = PoolAllocator::GetOwner( ptr );
+    WindAssert( std::ranges::any_of( _pools, [pOwner]( const auto& pool ) { return pool.get() == pOwner; } ),
+                "Pointer was not allocated from this allocator." );
+    pOwner->Free( ptr );
+}
+
+auto SizeClassAllocator::GetPool( size_t size ) const -> PoolAllocator*
+{
+    if ( size > kMaxSizeClass )
+    {
+        return nullptr;
+    }
+    const auto sizeClass = std::bit_ceil( std::max( size, kMinSizeClass ) );
+    const auto index = std::countr_zero( sizeClass ) - std::countr_zero( kMinSizeClass );
+    return _pools[static_cast<size_t>( index )].get();
+}
+
+}  // namespace WindEngine::Core::Memory
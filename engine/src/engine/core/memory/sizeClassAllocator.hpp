@@ -0,0 +1,40 @@
+#ifndef WINDENGINE_SIZECLASSALLOCATOR_HPP
+#define WINDENGINE_SIZECLASSALLOCATOR_HPP
+
+#include "allocator.hpp"
+#include "poolAllocator.hpp"
+#include <array>
+#include <memory>
+
+namespace WindEngine::Core::Memory
+{
+
+constexpr size_t kMinSizeClass = 16;
+constexpr size_t kMaxSizeClass = 2048;
+constexpr size_t kSizeClassCount = 8;  // 16, 32, ..., 2048
+
+// Routes small allocations to the pool of the next power of two. Larger requests, and alignments the pool slots can
+// not guarantee, return nullptr.
+class SizeClassAllocator : public Allocator
+{
+public:
+    SizeClassAllocator();
+    ~SizeClassAllocator() override = default;
+    SizeClassAllocator( const SizeClassAllocator& ) = delete;
+    SizeClassAllocator( const SizeClassAllocator&& ) = delete;
+    auto operator=( const SizeClassAllocator& ) -> SizeClassAllocator& = delete;
+    auto operator=( const SizeClassAllocator&& ) -> SizeClassAllocator& = delete;
+
+    void Init() override;
+    auto Allocate( size_t size, size_t alignment ) -> void* override;
+    void Free( void* ptr ) override;
+
+    [[nodiscard]] auto GetPool( size_t size ) const -> PoolAllocator*;
+
+private:
+    std::array<std::unique_ptr<PoolAllocator>, kSizeClassCount> _pools;
+};
+
+}  // namespace WindEngine::Core::Memory
+
+#endif  // WINDENGINE_SIZECLASSALLOCATOR_HPP
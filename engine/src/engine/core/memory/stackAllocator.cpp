@@ -0,0 +1,80 @@
+#include "stackAllocator.hpp"
+#include "core/assert.hpp"
+#include "core/logger.hpp"
+#include "memoryUtils.hpp"
+
+namespace WindEngine::Core::Memory
+{
+
+StackAllocator::StackAllocator( size_t size, size_t alignment ) : Allocator( size ), _alignment( alignment )
+{
+    WindAssert( IsPowerOfTwo( alignment ), "StackAllocator alignment has to be a power of two." );
+}
+
+StackAllocator::~StackAllocator()
+{
+    AlignedFree( _pStart );
+    _pStart = nullptr;
+}
+
+void StackAllocator::Init()
+{
+    AlignedFree( _pStart );
+    _pStart = static_cast<std::byte*>( AlignedAlloc( GetSize(), _alignment ) );
+    _offset = 0;
+    WindDebug( "StackAllocator::Init" );
+}
+
+auto StackAllocator::Allocate( size_t size, size_t alignment ) -> void*
+{
+    WindAssert( IsPowerOfTwo( alignment ), "StackAllocator alignment has to be a power of two." );
+    const auto base = reinterpret_cast<uintptr_t>( _pStart );
+    const auto start = AlignUp( base + _offset, alignment ) - base;
+    if ( start + size > GetSize() )
+    {
+        WindError( "StackAllocator is out of memory. Requested {} bytes with {} bytes left.", size,
+                   GetSize() - _offset );
+        return nullptr;
+    }
+
+    _offset = start + size;
+    return _pStart + start;
+}
+
+void StackAllocator::Free( [[maybe_unused]] void* ptr )
+{
+    WindAssert( false, "StackAllocator::FreeToMarker should be used instead." );
+}
+
+void StackAllocator::FreeToMarker( Marker marker )
+{
+    WindAssert( marker <= _offset, "StackAllocator marker is above the top of the stack." );
+    _offset = marker;
+}
+
+void StackAllocator::Reset()
+{
+    _offset = 0;
+}
+
+StackAllocatorScope::StackAllocatorScope( StackAllocator& allocator )
+  : _allocator( allocator ), _marker( allocator.GetMarker() )
+{
+}
+
+StackAllocatorScope::~StackAllocatorScope()
+{
+    _allocator.FreeToMarker( _marker );
+}
+
+auto GetThreadScratchStack() -> StackAllocator&
+{
+    thread_local const auto upScratch = [] {
+        auto upStack = std::make_unique<StackAllocator>( kThreadScratchStackSize );
+        upStack->Init();
+        return upStack;
+    }();
+    return *upScratch;
+}
+
+}  // namespace WindEngine::Core::Memory
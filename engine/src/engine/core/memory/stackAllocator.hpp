@@ -0,0 +1,79 @@
+#ifndef WINDENGINE_STACKALLOCATOR_HPP
+#define WINDENGINE_STACKALLOCATOR_HPP
+
+#include "allocator.hpp"
+
+namespace WindEngine::Core::Memory
+{
+
+constexpr size_t kDefaultStackAlignment = 16;
+constexpr size_t kThreadScratchStackSize = 1024 * 1024;
+
+// LIFO allocator. Memory is released by rolling back to a marker taken earlier.
+class StackAllocator : public Allocator
+{
+public:
+    using Marker = size_t;
+
+    explicit StackAllocator( size_t size, size_t alignment = kDefaultStackAlignment );
+    ~StackAllocator() override;
+    StackAllocator( const StackAllocator& ) = delete;
+    StackAllocator( const StackAllocator&& ) = delete;
+    auto operator=( const StackAllocator& ) -> StackAllocator& = delete;
+    auto operator=( const StackAllocator&& ) -> StackAllocator& = delete;
+
+    void Init() override;
+    auto Allocate( size_t size, size_t alignment ) -> void* override;
+    void Free( void* ptr ) override;
+
+    [[nodiscard]] auto CanFree() const -> bool override
+    {
+        return false;
+    }
+
+    [[nodiscard]] auto GetMarker() const -> Marker
+    {
+        return _offset;
+    }
+
+    void FreeToMarker( Marker marker );
+    void Reset();
+
+    [[nodiscard]] auto GetUsed() const -> size_t
+    {
+        return _offset;
+    }
+
+    [[nodiscard]] auto GetAlignment() const -> size_t
+    {
+        return _alignment;
+    }
+
+private:
+    std::byte* _pStart { nullptr };
+    size_t _offset { 0 };
+    size_t _alignment;
+};
+
+// Rolls the stack back to where it was when the scope was entered
+class StackAllocatorScope
+{
+public:
+    explicit StackAllocatorScope( StackAllocator& allocator );
+    ~StackAllocatorScope();
+    StackAllocatorScope( const StackAllocatorScope& ) = delete;
+    StackAllocatorScope( const StackAllocatorScope&& ) = delete;
+    auto operator=( const StackAllocatorScope& ) -> StackAllocatorScope& = delete;
+    auto operator=( const StackAllocatorScope&& ) -> StackAllocatorScope& = delete;
+
+private:
+    StackAllocator& _allocator;
+    StackAllocator::Marker _marker;
+};
+
+// Scratch stack owned by the calling thread, created on first use
+auto GetThreadScratchStack() -> StackAllocator&;
+
+}  // namespace WindEngine::Core::Memory
+
+#endif  // WINDENGINE_STACKALLOCATOR_HPP
@@ -0,0 +1,358 @@
+#include "tlsfAllocator.hpp"
+#include "core/assert.hpp"
+#include "core/logger.hpp"
+#include "memoryUtils.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace WindEngine::Core::Memory
+{
+
+static constexpr size_t kFreeFlag = 1;
+
+static auto FindLastSet( size_t value ) -> size_t
+{
+    return static_cast<size_t>( std::bit_width( value ) ) - 1;
+}
+
+auto TlsfAllocator::BlockHeader::GetSize() const -> size_t
+{
+    return sizeAndFlags & ~kFreeFlag;
+}
+
+auto TlsfAllocator::BlockHeader::IsFree() const -> bool
+{
+    return ( sizeAndFlags & kFreeFlag ) != 0;
+}
+
+void TlsfAllocator::BlockHeader::SetSize( size_t size )
+{
+    sizeAndFlags = size | ( sizeAndFlags & kFreeFlag );
+}
+
+void TlsfAllocator::BlockHeader::SetFree( bool isFree )
+{
+    sizeAndFlags = isFree ? sizeAndFlags | kFreeFlag : sizeAndFlags & ~kFreeFlag;
+}
+
+auto TlsfAllocator::BlockHeader::GetPayload() -> std::byte*
+{
+    return reinterpret_cast<std::byte*>( this ) + kHeaderSize;
+}
+
+auto TlsfAllocator::BlockHeader::GetNextPhysical() -> BlockHeader*
+{
+    return reinterpret_cast<BlockHeader*>( GetPayload() + GetSize() );
+}
+
+auto TlsfAllocator::BlockHeader::FromPayload( void* ptr ) -> BlockHeader*
+{
+    return reinterpret_cast<BlockHeader*>( static_cast<std::byte*>( ptr ) - kHeaderSize );
+}
+
+TlsfAllocator::TlsfAllocator( size_t poolSize, bool useHugePages )
+  : Allocator( 0 ), _poolSize( AlignUp( poolSize, kAlignment ) ), _useHugePages( useHugePages )
+{
+}
+
+TlsfAllocator::~TlsfAllocator()
+{
+    ReleasePools();
+}
+
+void TlsfAllocator::Init()
+{
+    const std::scoped_lock lock( _mutex );
+    ReleasePools();
+    AddPool( 0 );
+    WindDebug( "TlsfAllocator::Init with {} byte pools.", _poolSize );
+}
+
+auto TlsfAllocator::Allocate( size_t size, size_t alignment ) -> void*
+{
+    WindAssert( IsPowerOfTwo( alignment ), "TlsfAllocator alignment has to be a power of two." );
+    const auto blockSize = std::max( AlignUp( size, kAlignment ), kMinBlockSize );
+
+    // Over-aligned requests search for enough room to split a free block off in front of the aligned payload
+    const auto isOverAligned = alignment > kAlignment;
+    const auto searchSize = isOverAligned ? blockSize + alignment + kMinGapSize : blockSize;
+    if ( FindLastSet( searchSize ) >= kFirstLevelMax )
+    {
+        WindError( "TlsfAllocator can not allocate {} bytes aligned to {}.", size, alignment );
+        return nullptr;
+    }
+
+    const std::scoped_lock lock( _mutex );
+    auto* pBlock = FindFreeBlock( searchSize );
+    if ( pBlock == nullptr )
+    {
+        if ( !AddPool( searchSize ) )
+        {
+            return nullptr;
+        }
+        pBlock = FindFreeBlock( searchSize );
+    }
+    WindAssert( pBlock != nullptr, "TlsfAllocator failed to find a block in a fresh pool." );
+
+    RemoveFreeBlock( pBlock );
+    if ( isOverAligned )
+    {
+        pBlock = TrimLeading( pBlock, alignment );
+    }
+    SplitBlock( pBlock, blockSize );
+    pBlock->SetFree( false );
+    _used += pBlock->GetSize();
+
+    return pBlock->GetPayload();
+}
+
+void TlsfAllocator::Free( void* ptr )
+{
+    if ( ptr == nullptr )
+    {
+        return;
+    }
+
+    const std::scoped_lock lock( _mutex );
+    auto* pBlock = BlockHeader::FromPayload( ptr );
+    WindAssert( !pBlock->IsFree(), "TlsfAllocator double free." );
+
+    _used -= pBlock->GetSize();
+    pBlock->SetFree( true );
+    InsertFreeBlock( MergeWithNeighbours( pBlock ) );
+}
+
+auto TlsfAllocator::GetUsed() const -> size_t
+{
+    const std::scoped_lock lock( _mutex );
+    return _used;
+}
+
+auto TlsfAllocator::GetPoolCount() const -> size_t
+{
+    const std::scoped_lock lock( _mutex );
+    return _pools.size();
+}
+
+auto TlsfAllocator::GetHugePagePoolCount() const -> size_t
+{
+    const std::scoped_lock lock( _mutex );
+    return static_cast<size_t>( std::ranges::count_if(
+      _pools, []( const VirtualMapping& pool ) { return pool.backing != PageBacking::NORMAL; } ) );
+}
+
+auto TlsfAllocator::MapInsert( size_t size ) -> Mapping
+{
+    if ( size < kSmallBlockSize )
+    {
+        return { .firstLevel = 0, .secondLevel = size / ( kSmallBlockSize / kSecondLevelCount ) };
+    }
+    const auto firstLevel = FindLastSet( size );
+    const auto secondLevel = ( size >> ( firstLevel - kSecondLevelLog2 ) ) ^ kSecondLevelCount;
+    return { .firstLevel = firstLevel - ( kFirstLevelShift - 1 ), .secondLevel = secondLevel };
+}
+
+auto TlsfAllocator::MapSearch( size_t size ) -> Mapping
+{
+    // Round up to the next list so that every block in the found list is large enough
+    if ( size >= kSmallBlockSize )
+    {
+        size += ( size_t { 1 } << ( FindLastSet( size ) - kSecondLevelLog2 ) ) - 1;
+    }
+    return MapInsert( size );
+}
+
+auto TlsfAllocator::AddPool( size_t minimumBlockSize ) -> bool
+{
+    // The block has to survive the rounding in MapSearch to be found for minimumBlockSize
+    const auto blockSize = AlignUp( minimumBlockSize + ( minimumBlockSize >> kSecondLevelLog2 ), kAlignment );
+    auto poolSize = std::max( _poolSize, blockSize + 2 * kHeaderSize );
+    auto pool = VirtualMapping { .ptr = nullptr, .size = poolSize, .backing = PageBacking::NORMAL };
+    if ( _useHugePages )
+    {
+        // The mapping is rounded up to whole huge pages, hand the extra bytes to the pool as well
+        pool = MapHugePageMemory( poolSize );
+        poolSize = pool.size;
+    }
+    else
+    {
+        pool.ptr = AlignedAlloc( poolSize, kAlignment );
+    }
+    if ( pool.ptr == nullptr )
+    {
+        WindError( "TlsfAllocator failed to allocate a pool of {} bytes.", poolSize );
+        return false;
+    }
+    _pools.push_back( pool );
+    auto* pMemory = static_cast<std::byte*>( pool.ptr );
+
+    auto* pBlock = reinterpret_cast<BlockHeader*>( pMemory );
+    pBlock->prevPhysical = nullptr;
+    pBlock->sizeAndFlags = 0;
+    pBlock->SetSize( poolSize - 2 * kHeaderSize );
+    pBlock->SetFree( true );
+
+    // Zero sized used block at the end of the pool stops merging past it
+    auto* pSentinel = pBlock->GetNextPhysical();
+    pSentinel->prevPhysical = pBlock;
+    pSentinel->sizeAndFlags = 0;
+
+    InsertFreeBlock( pBlock );
+    WindDebug( "TlsfAllocator added pool {} of {} bytes with {}.", _pools.size(), poolSize,
+               GetPageBackingName( pool.backing ) );
+    return true;
+}
+
+auto TlsfAllocator::FindFreeBlock( size_t size ) -> BlockHeader*
+{
+    auto [firstLevel, secondLevel] = MapSearch( size );
+    if ( firstLevel >= kFirstLevelCount )
+    {
+        return nullptr;
+    }
+
+    auto secondLevelMap = _secondLevelBitmaps[firstLevel] & ( ~0U << secondLevel );
+    if ( secondLevelMap == 0 )
+    {
+        const auto firstLevelMap = _firstLevelBitmap & ( ~0U << ( firstLevel + 1 ) );
+        if ( firstLevelMap == 0 )
+        {
+            return nullptr;
+        }
+        firstLevel = static_cast<size_t>( std::countr_zero( firstLevelMap ) );
+        secondLevelMap = _secondLevelBitmaps[firstLevel];
+    }
+    secondLevel = static_cast<size_t>( std::countr_zero( secondLevelMap ) );
+    return _freeLists[firstLevel][secondLevel];
+}
+
+void TlsfAllocator::InsertFreeBlock( BlockHeader* pBlock )
+{
+    const auto [firstLevel, secondLevel] = MapInsert( pBlock->GetSize() );
+    auto*& pHead = _freeLists[firstLevel][secondLevel];
+
+    pBlock->prevFree = nullptr;
+    pBlock->nextFree = pHead;
+    if ( pHead != nullptr )
+    {
+        pHead->prevFree = pBlock;
+    }
+    pHead = pBlock;
+
+    _firstLevelBitmap |= 1U << firstLevel;
+    _secondLevelBitmaps[firstLevel] |= 1U << secondLevel;
+}
+
+void TlsfAllocator::RemoveFreeBlock( BlockHeader* pBlock )
+{
+    const auto [firstLevel, secondLevel] = MapInsert( pBlock->GetSize() );
+    auto*& pHead = _freeLists[firstLevel][secondLevel];
+
+    if ( pBlock->prevFree != nullptr )
+    {
+        pBlock->prevFree->nextFree = pBlock->nextFree;
+    }
+    if ( pBlock->nextFree != nullptr )
+    {
+        pBlock->nextFree->prevFree = pBlock->prevFree;
+    }
+    if ( pHead == pBlock )
+    {
+        pHead = pBlock->nextFree;
+        if ( pHead == nullptr )
+        {
+            _secondLevelBitmaps[firstLevel] &= ~( 1U << secondLevel );
+            if ( _secondLevelBitmaps[firstLevel] == 0 )
+            {
+                _firstLevelBitmap &= ~( 1U << firstLevel );
+            }
+        }
+    }
+}
+
+void TlsfAllocator::SplitBlock( BlockHeader* pBlock, size_t size )
+{
+    if ( pBlock->GetSize() < size + kHeaderSize + kMinBlockSize )
+    {
+        return;
+    }
+
+    auto* pRemaining = reinterpret_cast<BlockHeader*>( pBlock->GetPayload() + size );
+    pRemaining->prevPhysical = pBlock;
+    pRemaining->sizeAndFlags = 0;
+    pRemaining->SetSize( pBlock->GetSize() - size - kHeaderSize );
+    pRemaining->SetFree( true );
+    pBlock->SetSize( size );
+    pRemaining->GetNextPhysical()->prevPhysical = pRemaining;
+
+    InsertFreeBlock( pRemaining );
+}
+
+auto TlsfAllocator::TrimLeading( BlockHeader* pBlock, size_t alignment ) -> BlockHeader*
+{
+    const auto payload = reinterpret_cast<uintptr_t>( pBlock->GetPayload() );
+    auto gap = AlignUp( payload, alignment ) - payload;
+    if ( gap == 0 )
+    {
+        return pBlock;
+    }
+    if ( gap < kMinGapSize )
+    {
+        gap = AlignUp( payload + kMinGapSize, alignment ) - payload;
+    }
+
+    // The leading part stays free, its previous physical block is in use since free blocks are always merged
+    auto* pAligned = reinterpret_cast<BlockHeader*>( pBlock->GetPayload() + gap - kHeaderSize );
+    pAligned->prevPhysical = pBlock;
+    pAligned->sizeAndFlags = 0;
+    pAligned->SetSize( pBlock->GetSize() - gap );
+    pAligned->GetNextPhysical()->prevPhysical = pAligned;
+    pBlock->SetSize( gap - kHeaderSize );
+
+    InsertFreeBlock( pBlock );
+    return pAligned;
+}
+
+auto TlsfAllocator::MergeWithNeighbours( BlockHeader* pBlock ) -> BlockHeader*
+{
+    auto* pPrev = pBlock->prevPhysical;
+    if ( pPrev != nullptr && pPrev->IsFree() )
+    {
+        RemoveFreeBlock( pPrev );
+        pPrev->SetSize( pPrev->GetSize() + kHeaderSize + pBlock->GetSize() );
+        pPrev->GetNextPhysical()->prevPhysical = pPrev;
+        pBlock = pPrev;
+    }
+
+    auto* pNext = pBlock->GetNextPhysical();
+    if ( pNext->IsFree() )
+    {
+        RemoveFreeBlock( pNext );
+        pBlock->SetSize( pBlock->GetSize() + kHeaderSize + pNext->GetSize() );
+        pBlock->GetNextPhysical()->prevPhysical = pBlock;
+    }
+
+    return pBlock;
+}
+
+void TlsfAllocator::ReleasePools()
+{
+    for ( const auto& pool : _pools )
+    {
+        if ( _useHugePages )
+        {
+            ReleaseVirtualMemory( pool.ptr, pool.size );
+        }
+        else
+        {
+            AlignedFree( pool.ptr );
+        }
+    }
+    _pools.clear();
+    _used = 0;
+    _firstLevelBitmap = 0;
+    _secondLevelBitmaps = {};
+    _freeLists = {};
+}
+
+}  // namespace WindEngine::Core::Memory
@@ -0,0 +1,101 @@
+#ifndef WINDENGINE_TLSFALLOCATOR_HPP
+#define WINDENGINE_TLSFALLOCATOR_HPP
+
+#include "allocator.hpp"
+#include "virtualMemory.hpp"
+#include <array>
+#include <mutex>
+#include <vector>
+
+namespace WindEngine::Core::Memory
+{
+
+constexpr size_t kTlsfDefaultPoolSize = 32 * 1024 * 1024;
+
+// Two-Level Segregated Fit allocator. Allocate and Free run in bounded time: the first level splits free blocks by
+// power of two, the second level splits each power of two linearly, and two bitmaps find a fitting list without
+// searching. Memory comes from pools owned by the allocator, a new pool is added when no free block fits. With
+// useHugePages the pools are mapped on huge pages where the system allows it.
+class TlsfAllocator : public Allocator
+{
+public:
+    explicit TlsfAllocator( size_t poolSize = kTlsfDefaultPoolSize, bool useHugePages = false );
+    ~TlsfAllocator() override;
+    TlsfAllocator( const TlsfAllocator& ) = delete;
+    TlsfAllocator( const TlsfAllocator&& ) = delete;
+    auto operator=( const TlsfAllocator& ) -> TlsfAllocator& = delete;
+    auto operator=( const TlsfAllocator&& ) -> TlsfAllocator& = delete;
+
+    void Init() override;
+    auto Allocate( size_t size, size_t alignment ) -> void* override;
+    void Free( void* ptr ) override;
+
+    // Locked like the allocation paths, other threads may be allocating while the stats are read
+    [[nodiscard]] auto GetUsed() const -> size_t;
+    [[nodiscard]] auto GetPoolCount() const -> size_t;
+    [[nodiscard]] auto GetHugePagePoolCount() const -> size_t;
+
+    static constexpr size_t kAlignmentLog2 = 4;
+    static constexpr size_t kAlignment = 1 << kAlignmentLog2;
+    static constexpr size_t kSecondLevelLog2 = 5;
+    static constexpr size_t kSecondLevelCount = 1 << kSecondLevelLog2;
+    static constexpr size_t kFirstLevelShift = kSecondLevelLog2 + kAlignmentLog2;
+    static constexpr size_t kFirstLevelMax = 38;
+    static constexpr size_t kFirstLevelCount = kFirstLevelMax - kFirstLevelShift + 1;
+    static constexpr size_t kSmallBlockSize = 1 << kFirstLevelShift;
+
+private:
+    struct BlockHeader
+    {
+        BlockHeader* prevPhysical;
+        size_t sizeAndFlags;
+
+        // Only valid while the block is free, they overlap the payload
+        BlockHeader* nextFree;
+        BlockHeader* prevFree;
+
+        [[nodiscard]] auto GetSize() const -> size_t;
+        [[nodiscard]] auto IsFree() const -> bool;
+        void SetSize( size_t size );
+        void SetFree( bool isFree );
+        [[nodiscard]] auto GetPayload() -> std::byte*;
+        [[nodiscard]] auto GetNextPhysical() -> BlockHeader*;
+        [[nodiscard]] static auto FromPayload( void* ptr ) -> BlockHeader*;
+    };
+
+    struct Mapping
+    {
+        size_t firstLevel;
+        size_t secondLevel;
+    };
+
+    static constexpr size_t kHeaderSize = offsetof( BlockHeader, nextFree );
+    static constexpr size_t kMinBlockSize = sizeof( BlockHeader ) - kHeaderSize;
+    // Smallest distance to an aligned payload that still leaves a valid free block in front of it
+    static constexpr size_t kMinGapSize = kHeaderSize + kMinBlockSize;
+
+    [[nodiscard]] static auto MapInsert( size_t size ) -> Mapping;
+    [[nodiscard]] static auto MapSearch( size_t size ) -> Mapping;
+
+    auto AddPool( size_t minimumBlockSize ) -> bool;
+    auto FindFreeBlock( size_t size ) -> BlockHeader*;
+    void InsertFreeBlock( BlockHeader* pBlock );
+    void RemoveFreeBlock( BlockHeader* pBlock );
+    void SplitBlock( BlockHeader* pBlock, size_t size );
+    auto TrimLeading( BlockHeader* pBlock, size_t alignment ) -> BlockHeader*;
+    auto MergeWithNeighbours( BlockHeader* pBlock ) -> BlockHeader*;
+    void ReleasePools();
+
+    size_t _poolSize;
+    bool _useHugePages;
+    size_t _used { 0 };
+    U32 _firstLevelBitmap { 0 };
+    std::array<U32, kFirstLevelCount> _secondLevelBitmaps {};
+    std::array<std::array<BlockHeader*, kSecondLevelCount>, kFirstLevelCount> _freeLists {};
+    std::vector<VirtualMapping> _pools;
+    mutable std::mutex _mutex;
+};
+
+}  // namespace WindEngine::Core::Memory
+
+#endif  // WINDENGINE_TLSFALLOCATOR_HPP
@@ -0,0 +1,97 @@
+#include "virtualLinearAllocator.hpp"
+#include "core/assert.hpp"
+#include "core/logger.hpp"
+#include "memoryUtils.hpp"
+#include <algorithm>
+
+namespace WindEngine::Core::Memory
+{
+
+static auto GetCommitGranularity( const VirtualArenaInfo& info ) -> size_t
+{
+    return info.useHugePages ? kHugePageSize : kVirtualCommitGranularity;
+}
+
+VirtualLinearAllocator::VirtualLinearAllocator( size_t reserveSize, const VirtualArenaInfo& info )
+  : Allocator( AlignUp( reserveSize, GetCommitGranularity( info ) ) ),
+    _commitGranularity( GetCommitGranularity( info ) ), _info( info )
+{
+}
+
+VirtualLinearAllocator::~VirtualLinearAllocator()
+{
+    Release();
+}
+
+void VirtualLinearAllocator::Init()
+{
+    Release();
+    if ( _info.useHugePages )
+    {
+        const auto mapping = ReserveHugePageMemory( GetSize() );
+        _pStart = static_cast<std::byte*>( mapping.ptr );
+        _backing = mapping.backing;
+    }
+    else
+    {
+        _pStart = static_cast<std::byte*>( ReserveVirtualMemory( GetSize() ) );
+        _backing = PageBacking::NORMAL;
+    }
+    WindDebug( "VirtualLinearAllocator::Init reserved {} bytes with {}.", GetSize(), GetPageBackingName( _backing ) );
+}
+
+auto VirtualLinearAllocator::Allocate( size_t size, size_t alignment ) -> void*
+{
+    WindAssert( IsPowerOfTwo( alignment ), "VirtualLinearAllocator alignment has to be a power of two." );
+    if ( _pStart == nullptr )
+    {
+        return nullptr;
+    }
+
+    const auto base = reinterpret_cast<uintptr_t>( _pStart );
+    const auto start = AlignUp( base + _offset, alignment ) - base;
+    const auto end = start + size;
+    if ( end > GetSize() )
+    {
+        WindError( "VirtualLinearAllocator reservation of {} bytes is exhausted.", GetSize() );
+        return nullptr;
+    }
+
+    if ( end > _committed )
+    {
+        const auto committed = std::min( AlignUp( end, _commitGranularity ), GetSize() );
+        if ( !CommitVirtualMemory( _pStart + _committed, committed - _committed ) )
+        {
+            return nullptr;
+        }
+        _committed = committed;
+    }
+
+    _offset = end;
+    return _pStart + start;
+}
+
+void VirtualLinearAllocator::Free( [[maybe_unused]] void* ptr )
+{
+    WindAssert( false, "VirtualLinearAllocator::Reset should be used instead." );
+}
+
+void VirtualLinearAllocator::Reset()
+{
+    _offset = 0;
+    if ( _info.decommitOnReset && _committed != 0 )
+    {
+        DecommitVirtualMemory( _pStart, _committed );
+        _committed = 0;
+    }
+}
+
+void VirtualLinearAllocator::Release()
+{
+    ReleaseVirtualMemory( _pStart, GetSize() );
+    _pStart = nullptr;
+    _offset = 0;
+    _committed = 0;
+}
+
+}  // namespace WindEngine::Core::Memory
@@ -0,0 +1,71 @@
+#ifndef WINDENGINE_VIRTUALLINEARALLOCATOR_HPP
+#define WINDENGINE_VIRTUALLINEARALLOCATOR_HPP
+
+#include "allocator.hpp"
+#include "virtualMemory.hpp"
+
+namespace WindEngine::Core::Memory
+{
+
+constexpr size_t kVirtualCommitGranularity = 64 * 1024;
+
+struct VirtualArenaInfo
+{
+    // Give the committed pages back to the OS on Reset
+    bool decommitOnReset { false };
+    // Reserve on a huge page boundary and commit in kHugePageSize steps so the range can use huge pages
+    bool useHugePages { false };
+};
+
+// Linear allocator over a reserved range of address space. The size given to the constructor is only reserved,
+// pages are committed in kVirtualCommitGranularity steps as the offset grows, so a generous capacity costs no
+// resident memory until it is used.
+class VirtualLinearAllocator : public Allocator
+{
+public:
+    explicit VirtualLinearAllocator( size_t reserveSize, const VirtualArenaInfo& info = {} );
+    ~VirtualLinearAllocator() override;
+    VirtualLinearAllocator( const VirtualLinearAllocator& ) = delete;
+    VirtualLinearAllocator( const VirtualLinearAllocator&& ) = delete;
+    auto operator=( const VirtualLinearAllocator& ) -> VirtualLinearAllocator& = delete;
+    auto operator=( const VirtualLinearAllocator&& ) -> VirtualLinearAllocator& = delete;
+
+    void Init() override;
+    auto Allocate( size_t size, size_t alignment ) -> void* override;
+    void Free( void* ptr ) override;
+
+    [[nodiscard]] auto CanFree() const -> bool override
+    {
+        return false;
+    }
+    void Reset();
+
+    [[nodiscard]] auto GetUsed() const -> size_t
+    {
+        return _offset;
+    }
+
+    [[nodiscard]] auto GetCommitted() const -> size_t
+    {
+        return _committed;
+    }
+
+    [[nodiscard]] auto GetPageBacking() const -> PageBacking
+    {
+        return _backing;
+    }
+
+private:
+    void Release();
+
+    std::byte* _pStart { nullptr };
+    size_t _offset { 0 };
+    size_t _committed { 0 };
+    size_t _commitGranularity;
+    PageBacking _backing { PageBacking::NORMAL };
+    VirtualArenaInfo _info;
+};
+
+}  // namespace WindEngine::Core::Memory
+
+#endif  // WINDENGINE_VIRTUALLINEARALLOCATOR_HPP
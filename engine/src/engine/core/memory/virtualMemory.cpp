@@ -0,0 +1,187 @@
+#include "virtualMemory.hpp"
+#include "core/logger.hpp"
+#include "memoryUtils.hpp"
+
+#if defined( _WIN32 )
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace WindEngine::Core::Memory
+{
+
+#if !defined( _WIN32 )
+// mmap only guarantees page alignment, so map the slack and unmap whatever falls outside the aligned range
+static auto MapAligned( size_t size, size_t alignment, int protection ) -> void*
+{
+    const auto mappedSize = size + alignment;
+    auto* ptr = mmap( nullptr, mappedSize, protection, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+    if ( ptr == MAP_FAILED )
+    {
+        return nullptr;
+    }
+
+    auto* pStart = static_cast<std::byte*>( ptr );
+    auto* pAligned = static_cast<std::byte*>( AlignUp( ptr, alignment ) );
+    if ( pAligned != pStart )
+    {
+        munmap( pStart, static_cast<size_t>( pAligned - pStart ) );
+    }
+    const auto tailSize = static_cast<size_t>( pStart + mappedSize - ( pAligned + size ) );
+    if ( tailSize != 0 )
+    {
+        munmap( pAligned + size, tailSize );
+    }
+    return pAligned;
+}
+
+static auto AdviseHugePages( void* ptr, size_t size ) -> PageBacking
+{
+#if defined( MADV_HUGEPAGE )
+    if ( madvise( ptr, size, MADV_HUGEPAGE ) == 0 )
+    {
+        return PageBacking::TRANSPARENT_HUGE_PAGES;
+    }
+#endif
+    return PageBacking::NORMAL;
+}
+#endif
+
+auto GetPageSize() -> size_t
+{
+#if defined( _WIN32 )
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo( &systemInfo );
+    return systemInfo.dwPageSize;
+#else
+    return static_cast<size_t>( sysconf( _SC_PAGESIZE ) );
+#endif
+}
+
+auto ReserveVirtualMemory( size_t size ) -> void*
+{
+#if defined( _WIN32 )
+    auto* ptr = VirtualAlloc( nullptr, size, MEM_RESERVE, PAGE_NOACCESS );
+#else
+    auto* ptr = mmap( nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+    if ( ptr == MAP_FAILED )
+    {
+        ptr = nullptr;
+    }
+#endif
+    if ( ptr == nullptr )
+    {
+        WindError( "Failed to reserve {} bytes of address space.", size );
+    }
+    return ptr;
+}
+
+auto CommitVirtualMemory( void* ptr, size_t size ) -> bool
+{
+#if defined( _WIN32 )
+    const auto isCommitted = VirtualAlloc( ptr, size, MEM_COMMIT, PAGE_READWRITE ) != nullptr;
+#else
+    const auto isCommitted = mprotect( ptr, size, PROT_READ | PROT_WRITE ) == 0;
+#endif
+    if ( !isCommitted )
+    {
+        WindError( "Failed to commit {} bytes of virtual memory.", size );
+    }
+    return isCommitted;
+}
+
+void DecommitVirtualMemory( void* ptr, size_t size )
+{
+#if defined( _WIN32 )
+    VirtualFree( ptr, size, MEM_DECOMMIT );
+#else
+    // Drop the physical pages first, then make the range inaccessible again like a fresh reservation
+    madvise( ptr, size, MADV_DONTNEED );
+    mprotect( ptr, size, PROT_NONE );
+#endif
+}
+
+void ReleaseVirtualMemory( void* ptr, [[maybe_unused]] size_t size )
+{
+    if ( ptr == nullptr )
+    {
+        return;
+    }
+#if defined( _WIN32 )
+    VirtualFree( ptr, 0, MEM_RELEASE );
+#else
+    munmap( ptr, size );
+#endif
+}
+
+auto ReserveHugePageMemory( size_t size ) -> VirtualMapping
+{
+    size = AlignUp( size, kHugePageSize );
+#if defined( _WIN32 )
+    // Large pages on Windows have to be committed up front, a lazily committed range gets normal pages
+    return { .ptr = ReserveVirtualMemory( size ), .size = size, .backing = PageBacking::NORMAL };
+#else
+    auto* ptr = MapAligned( size, kHugePageSize, PROT_NONE );
+    if ( ptr == nullptr )
+    {
+        WindError( "Failed to reserve {} bytes of address space.", size );
+        return { .ptr = nullptr, .size = size, .backing = PageBacking::NORMAL };
+    }
+    return { .ptr = ptr, .size = size, .backing = AdviseHugePages( ptr, size ) };
+#endif
+}
+
+auto MapHugePageMemory( size_t size ) -> VirtualMapping
+{
+#if defined( _WIN32 )
+    const auto largePageSize = GetLargePageMinimum();
+    if ( largePageSize != 0 )
+    {
+        const auto largeSize = AlignUp( size, largePageSize );
+        auto* ptr = VirtualAlloc( nullptr, largeSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE );
+        if ( ptr != nullptr )
+        {
+            return { .ptr = ptr, .size = largeSize, .backing = PageBacking::EXPLICIT_HUGE_PAGES };
+        }
+    }
+    size = AlignUp( size, kHugePageSize );
+    return { .ptr = VirtualAlloc( nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE ),
+             .size = size,
+             .backing = PageBacking::NORMAL };
+#else
+    size = AlignUp( size, kHugePageSize );
+#if defined( MAP_HUGETLB )
+    // Only succeeds when the system has huge pages reserved, e.g. through vm.nr_hugepages
+    auto* pExplicit = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+    if ( pExplicit != MAP_FAILED )
+    {
+        return { .ptr = pExplicit, .size = size, .backing = PageBacking::EXPLICIT_HUGE_PAGES };
+    }
+#endif
+    auto* ptr = MapAligned( size, kHugePageSize, PROT_READ | PROT_WRITE );
+    if ( ptr == nullptr )
+    {
+        WindError( "Failed to map {} bytes of memory.", size );
+        return { .ptr = nullptr, .size = size, .backing = PageBacking::NORMAL };
+    }
+    return { .ptr = ptr, .size = size, .backing = AdviseHugePages( ptr, size ) };
+#endif
+}
+
+auto GetPageBackingName( PageBacking backing ) -> const char*
+{
+    switch ( backing )
+    {
+    case PageBacking::NORMAL:
+        return "normal pages";
+    case PageBacking::TRANSPARENT_HUGE_PAGES:
+        return "transparent huge pages";
+    case PageBacking::EXPLICIT_HUGE_PAGES:
+        return "explicit huge pages";
+    }
+    return "unknown";
+}
+
+}  // namespace WindEngine::Core::Memory
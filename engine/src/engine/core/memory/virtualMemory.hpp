@@ -0,0 +1,44 @@
+#ifndef WINDENGINE_VIRTUALMEMORY_HPP
+#define WINDENGINE_VIRTUALMEMORY_HPP
+
+#include "defines.hpp"
+
+namespace WindEngine::Core::Memory
+{
+
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+enum class PageBacking
+{
+    NORMAL,
+    TRANSPARENT_HUGE_PAGES,
+    EXPLICIT_HUGE_PAGES
+};
+
+struct VirtualMapping
+{
+    void* ptr;
+    size_t size;
+    PageBacking backing;
+};
+
+// Thin wrappers over the OS virtual memory API. Reserved ranges take address space only, pages have to be committed
+// before use. Sizes and addresses passed to Commit and Decommit have to be page aligned.
+[[nodiscard]] auto GetPageSize() -> size_t;
+[[nodiscard]] auto ReserveVirtualMemory( size_t size ) -> void*;
+auto CommitVirtualMemory( void* ptr, size_t size ) -> bool;
+void DecommitVirtualMemory( void* ptr, size_t size );
+void ReleaseVirtualMemory( void* ptr, size_t size );
+
+// Reserves a kHugePageSize aligned range and asks the kernel to back it with transparent huge pages once committed.
+// Falls back to a normal reservation, the returned backing tells which one was made.
+[[nodiscard]] auto ReserveHugePageMemory( size_t size ) -> VirtualMapping;
+// Maps committed memory, trying explicit huge pages first, then transparent huge pages, then normal pages. The size
+// is rounded up to kHugePageSize, release the returned size with ReleaseVirtualMemory.
+[[nodiscard]] auto MapHugePageMemory( size_t size ) -> VirtualMapping;
+
+[[nodiscard]] auto GetPageBackingName( PageBacking backing ) -> const char*;
+
+}  // namespace WindEngine::Core::Memory
+
+#endif  // WINDENGINE_VIRTUALMEMORY_HPP
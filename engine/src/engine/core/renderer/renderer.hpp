@@ -22,6 +22,8 @@ class Renderer
 public:
     virtual auto Initialize( const AppConfig& config ) -> bool = 0;
     virtual void Shutdown() = 0;
+    // Blocks until the resources of the next frame slot are free again, called before BeginFrame
+    virtual auto WaitForFrame( AppState& state ) -> bool = 0;
     virtual auto BeginFrame( AppState& state ) -> bool = 0;
     virtual auto EndFrame( AppState& state ) -> bool = 0;
     virtual void Resize( U16 width, U16 height ) = 0;
@@ -0,0 +1,274 @@
+#include "vulkanBindlessDescriptors.hpp"
+#include "assert.hpp"
+#include "logger.hpp"
+#include <algorithm>
+
+namespace WindEngine::Core::Render
+{
+
+BindlessSlotAllocator::BindlessSlotAllocator( U32 capacity, std::pmr::memory_resource* pResource )
+  : _capacity( capacity ), _freeSlots( pResource ), _retiredSlots( pResource )
+{
+}
+
+auto BindlessSlotAllocator::Allocate() -> BindlessIndex
+{
+    if ( !_freeSlots.empty() )
+    {
+        const auto index = _freeSlots.back();
+        _freeSlots.pop_back();
+        return index;
+    }
+    if ( _nextUnused < _capacity )
+    {
+        return _nextUnused++;
+    }
+    return kInvalidBindlessIndex;
+}
+
+void BindlessSlotAllocator::Free( BindlessIndex index, U64 frameNumber )
+{
+    WindAssert( index < _nextUnused, "Freeing a bindless slot that was never allocated." );
+    _retiredSlots.push_back( { .index = index, .frameNumber = frameNumber } );
+}
+
+void BindlessSlotAllocator::Reclaim( U64 completedFrame )
+{
+    // Slots are retired in frame order
+    while ( !_retiredSlots.empty() && _retiredSlots.front().frameNumber <= completedFrame )
+    {
+        _freeSlots.push_back( _retiredSlots.front().index );
+        _retiredSlots.pop_front();
+    }
+}
+
+VulkanBindlessDescriptors::VulkanBindlessDescriptors( VulkanDevice& device, vk::AllocationCallbacks* allocator,
+                                                      std::pmr::memory_resource* pResource )
+  : VulkanHandle( &device, allocator ), _imageSlots( kMaxBindlessSampledImages, pResource ),
+    _bufferSlots( kMaxBindlessStorageBuffers, pResource )
+{
+}
+
+void VulkanBindlessDescriptors::Initialize( U32 framesInFlight )
+{
+    _framesInFlight = framesInFlight;
+
+    const auto properties =
+      _device->physicalDevice.getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceVulkan12Properties>();
+    const auto& properties12 = properties.get<vk::PhysicalDeviceVulkan12Properties>();
+    _imageSlots.SetCapacity( std::min( { kMaxBindlessSampledImages,
+                                         properties12.maxDescriptorSetUpdateAfterBindSampledImages,
+                                         properties12.maxPerStageDescriptorUpdateAfterBindSampledImages } ) );
+    _bufferSlots.SetCapacity( std::min( { kMaxBindlessStorageBuffers,
+                                          properties12.maxDescriptorSetUpdateAfterBindStorageBuffers,
+                                          properties12.maxPerStageDescriptorUpdateAfterBindStorageBuffers } ) );
+
+    CreateSamplers();
+
+    const auto bindings = std::array {
+        vk::DescriptorSetLayoutBinding { .binding = static_cast<U32>( BindlessBinding::SAMPLERS ),
+                                         .descriptorType = vk::DescriptorType::eSampler,
+                                         .descriptorCount = ToU32( _samplers.size() ),
+                                         .stageFlags = vk::ShaderStageFlagBits::eAll,
+                                         .pImmutableSamplers = _samplers.data() },
+        vk::DescriptorSetLayoutBinding { .binding = static_cast<U32>( BindlessBinding::SAMPLED_IMAGES ),
+                                         .descriptorType = vk::DescriptorType::eSampledImage,
+                                         .descriptorCount = _imageSlots.GetCapacity(),
+                                         .stageFlags = vk::ShaderStageFlagBits::eAll,
+                                         .pImmutableSamplers = nullptr },
+        vk::DescriptorSetLayoutBinding { .binding = static_cast<U32>( BindlessBinding::STORAGE_BUFFERS ),
+                                         .descriptorType = vk::DescriptorType::eStorageBuffer,
+                                         .descriptorCount = _bufferSlots.GetCapacity(),
+                                         .stageFlags = vk::ShaderStageFlagBits::eAll,
+                                         .pImmutableSamplers = nullptr },
+    };
+    // Slots that were never written or are only used by other draws may be left empty or rewritten while the set is
+    // bound
+    constexpr auto kArrayFlags = vk::DescriptorBindingFlagBits::eUpdateAfterBind |
+                                 vk::DescriptorBindingFlagBits::eUpdateUnusedWhilePending |
+                                 vk::DescriptorBindingFlagBits::ePartiallyBound;
+    const auto bindingFlags = std::array<vk::DescriptorBindingFlags, 3> { {}, kArrayFlags, kArrayFlags };
+    const auto bindingFlagsInfo =
+      vk::DescriptorSetLayoutBindingFlagsCreateInfo { .bindingCount = ToU32( bindingFlags.size() ),
+                                                      .pBindingFlags = bindingFlags.data() };
+    const auto setLayoutInfo =
+      vk::DescriptorSetLayoutCreateInfo { .pNext = &bindingFlagsInfo,
+                                          .flags = vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool,
+                                          .bindingCount = ToU32( bindings.size() ),
+                                          .pBindings = bindings.data() };
+    _setLayout = _device->device.createDescriptorSetLayout( setLayoutInfo, _allocator );
+
+    const auto poolSizes = std::array {
+        vk::DescriptorPoolSize { .type = vk::DescriptorType::eSampler, .descriptorCount = ToU32( _samplers.size() ) },
+        vk::DescriptorPoolSize { .type = vk::DescriptorType::eSampledImage,
+                                 .descriptorCount = _imageSlots.GetCapacity() },
+        vk::DescriptorPoolSize { .type = vk::DescriptorType::eStorageBuffer,
+                                 .descriptorCount = _bufferSlots.GetCapacity() },
+    };
+    const auto poolInfo = vk::DescriptorPoolCreateInfo { .flags = vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind,
+                                                         .maxSets = 1,
+                                                         .poolSizeCount = ToU32( poolSizes.size() ),
+                                                         .pPoolSizes = poolSizes.data() };
+    _pool = _device->device.createDescriptorPool( poolInfo, _allocator );
+
+    const auto setInfo =
+      vk::DescriptorSetAllocateInfo { .descriptorPool = _pool, .descriptorSetCount = 1, .pSetLayouts = &_setLayout };
+    _set = _device->device.allocateDescriptorSets( setInfo ).front();
+
+    const auto pushConstantRange = vk::PushConstantRange { .stageFlags = vk::ShaderStageFlagBits::eAll,
+                                                           .offset = 0,
+                                                           .size = kBindlessPushConstantSize };
+    const auto passBinding = vk::DescriptorSetLayoutBinding { .binding = 0,
+                                                              .descriptorType = vk::DescriptorType::eUniformBuffer,
+                                                              .descriptorCount = 1,
+                                                              .stageFlags = vk::ShaderStageFlagBits::eAll,
+                                                              .pImmutableSamplers = nullptr };
+    _passSetLayout = _device->device.createDescriptorSetLayout( { .bindingCount = 1, .pBindings = &passBinding },
+                                                                _allocator );
+
+    const auto setLayouts = std::array { _setLayout, _passSetLayout };
+    const auto layoutInfo = vk::PipelineLayoutCreateInfo { .setLayoutCount = ToU32( setLayouts.size() ),
+                                                           .pSetLayouts = setLayouts.data(),
+                                                           .pushConstantRangeCount = 1,
+                                                           .pPushConstantRanges = &pushConstantRange };
+    _pipelineLayout = _device->device.createPipelineLayout( layoutInfo, _allocator );
+
+    WindInfo( "Bindless set holds {} sampled images and {} storage buffers.", _imageSlots.GetCapacity(),
+              _bufferSlots.GetCapacity() );
+}
+
+void VulkanBindlessDescriptors::Destroy()
+{
+    _device->device.destroy( _pipelineLayout, _allocator );
+    // Destroying the pool frees the set
+    _device->device.destroy( _pool, _allocator );
+    _device->device.destroy( _setLayout, _allocator );
+    _device->device.destroy( _passSetLayout, _allocator );
+    for ( const auto& sampler : _samplers )
+    {
+        _device->device.destroy( sampler, _allocator );
+    }
+}
+
+void VulkanBindlessDescriptors::BeginFrame( U64 frameNumber )
+{
+    const std::scoped_lock lock( _mutex );
+    _frameNumber = frameNumber;
+    if ( frameNumber < _framesInFlight )
+    {
+        return;
+    }
+    _imageSlots.Reclaim( frameNumber - _framesInFlight );
+    _bufferSlots.Reclaim( frameNumber - _framesInFlight );
+}
+
+auto VulkanBindlessDescriptors::RegisterImage( const vk::ImageView& imageView, vk::ImageLayout imageLayout )
+  -> BindlessIndex
+{
+    const std::scoped_lock lock( _mutex );
+    const auto index = _imageSlots.Allocate();
+    if ( index == kInvalidBindlessIndex )
+    {
+        WindFatal( "Ran out of bindless image slots." );
+    }
+
+    const auto imageInfo =
+      vk::DescriptorImageInfo { .sampler = {}, .imageView = imageView, .imageLayout = imageLayout };
+    const auto write = vk::WriteDescriptorSet { .dstSet = _set,
+                                                .dstBinding = static_cast<U32>( BindlessBinding::SAMPLED_IMAGES ),
+                                                .dstArrayElement = index,
+                                                .descriptorCount = 1,
+                                                .descriptorType = vk::DescriptorType::eSampledImage,
+                                                .pImageInfo = &imageInfo };
+    _device->device.updateDescriptorSets( write, {} );
+    return index;
+}
+
+auto VulkanBindlessDescriptors::RegisterBuffer( const vk::Buffer& buffer, vk::DeviceSize offset, vk::DeviceSize range )
+  -> BindlessIndex
+{
+    const std::scoped_lock lock( _mutex );
+    const auto index = _bufferSlots.Allocate();
+    if ( index == kInvalidBindlessIndex )
+    {
+        WindFatal( "Ran out of bindless buffer slots." );
+    }
+
+    const auto bufferInfo = vk::DescriptorBufferInfo { .buffer = buffer, .offset = offset, .range = range };
+    const auto write = vk::WriteDescriptorSet { .dstSet = _set,
+                                                .dstBinding = static_cast<U32>( BindlessBinding::STORAGE_BUFFERS ),
+                                                .dstArrayElement = index,
+                                                .descriptorCount = 1,
+                                                .descriptorType = vk::DescriptorType::eStorageBuffer,
+                                                .pBufferInfo = &bufferInfo };
+    _device->device.updateDescriptorSets( write, {} );
+    return index;
+}
+
+void VulkanBindlessDescriptors::ReleaseImage( BindlessIndex index )
+{
+    const std::scoped_lock lock( _mutex );
+    _imageSlots.Free( index, _frameNumber );
+}
+
+void VulkanBindlessDescriptors::ReleaseBuffer( BindlessIndex index )
+{
+    const std::scoped_lock lock( _mutex );
+    _bufferSlots.Free( index, _frameNumber );
+}
+
+void VulkanBindlessDescriptors::Bind( const vk::CommandBuffer& commandBuffer, vk::PipelineBindPoint bindPoint ) const
+{
+    commandBuffer.bindDescriptorSets( bindPoint, _pipelineLayout, kBindlessSetIndex, _set, {} );
+}
+
+auto VulkanBindlessDescriptors::GetSetLayout() const -> const vk::DescriptorSetLayout&
+{
+    return _setLayout;
+}
+
+auto VulkanBindlessDescriptors::GetPassSetLayout() const -> const vk::DescriptorSetLayout&
+{
+    return _passSetLayout;
+}
+
+auto VulkanBindlessDescriptors::GetPipelineLayout() const -> const vk::PipelineLayout&
+{
+    return _pipelineLayout;
+}
+
+void VulkanBindlessDescriptors::PrintStats() const
+{
+    const std::scoped_lock lock( _mutex );
+    WindDebug( "[[Bindless Descriptors]]" );
+    WindDebug( "\tSampled Images: {} / {}", _imageSlots.GetUsedCount(), _imageSlots.GetCapacity() );
+    WindDebug( "\tStorage Buffers: {} / {}", _bufferSlots.GetUsedCount(), _bufferSlots.GetCapacity() );
+}
+
+void VulkanBindlessDescriptors::CreateSamplers()
+{
+    const auto createSampler = [this]( vk::Filter filter, vk::SamplerMipmapMode mipmapMode ) {
+        const auto samplerInfo = vk::SamplerCreateInfo { .magFilter = filter,
+                                                         .minFilter = filter,
+                                                         .mipmapMode = mipmapMode,
+                                                         .addressModeU = vk::SamplerAddressMode::eRepeat,
+                                                         .addressModeV = vk::SamplerAddressMode::eRepeat,
+                                                         .addressModeW = vk::SamplerAddressMode::eRepeat,
+                                                         .mipLodBias = 0.0F,
+                                                         .anisotropyEnable = VK_FALSE,
+                                                         .maxAnisotropy = 1.0F,
+                                                         .compareEnable = VK_FALSE,
+                                                         .compareOp = vk::CompareOp::eAlways,
+                                                         .minLod = 0.0F,
+                                                         .maxLod = VK_LOD_CLAMP_NONE,
+                                                         .borderColor = vk::BorderColor::eIntOpaqueBlack,
+                                                         .unnormalizedCoordinates = VK_FALSE };
+        return _device->device.createSampler( samplerInfo, _allocator );
+    };
+    _samplers[static_cast<size_t>( BindlessSampler::LINEAR )] =
+      createSampler( vk::Filter::eLinear, vk::SamplerMipmapMode::eLinear );
+    _samplers[static_cast<size_t>( BindlessSampler::NEAREST )] =
+      createSampler( vk::Filter::eNearest, vk::SamplerMipmapMode::eNearest );
+}
+
+}  // namespace WindEngine::Core::Render
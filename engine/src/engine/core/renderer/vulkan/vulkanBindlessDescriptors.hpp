@@ -0,0 +1,141 @@
+#ifndef WINDENGINE_VULKANBINDLESSDESCRIPTORS_HPP
+#define WINDENGINE_VULKANBINDLESSDESCRIPTORS_HPP
+
+#include "vulkanHandle.hpp"
+#include <array>
+#include <deque>
+#include <memory_resource>
+#include <mutex>
+
+namespace WindEngine::Core::Render
+{
+
+using BindlessIndex = U32;
+constexpr BindlessIndex kInvalidBindlessIndex = UINT32_MAX;
+
+// Upper bounds, the arrays are clamped to the update-after-bind limits of the device
+constexpr U32 kMaxBindlessSampledImages = 16384;
+constexpr U32 kMaxBindlessStorageBuffers = 4096;
+// The minimum every implementation guarantees
+constexpr U32 kBindlessPushConstantSize = 128;
+
+// Sets of the shared pipeline layout
+constexpr U32 kBindlessSetIndex = 0;
+// One uniform buffer per render pass, allocated every frame from the VulkanDescriptorAllocator
+constexpr U32 kPassSetIndex = 1;
+
+// Set 0 of every pipeline layout, shaders index the arrays with indices passed in push constants
+enum class BindlessBinding : U32
+{
+    SAMPLERS = 0,
+    SAMPLED_IMAGES = 1,
+    STORAGE_BUFFERS = 2
+};
+
+// Immutable samplers in the SAMPLERS binding
+enum class BindlessSampler : U32
+{
+    LINEAR = 0,
+    NEAREST = 1,
+    COUNT = 2
+};
+
+// Hands out array slots. A freed slot may still be read by frames in flight, so it only becomes available again once
+// the frame it was freed in has completed.
+struct BindlessSlotAllocator
+{
+    BindlessSlotAllocator( U32 capacity, std::pmr::memory_resource* pResource );
+
+    // kInvalidBindlessIndex when every slot is taken
+    [[nodiscard]] auto Allocate() -> BindlessIndex;
+    void Free( BindlessIndex index, U64 frameNumber );
+    // Makes the slots freed in or before completedFrame available again
+    void Reclaim( U64 completedFrame );
+
+    void SetCapacity( U32 capacity )
+    {
+        _capacity = capacity;
+    }
+
+    [[nodiscard]] auto GetCapacity() const -> U32
+    {
+        return _capacity;
+    }
+
+    [[nodiscard]] auto GetUsedCount() const -> U32
+    {
+        return _nextUnused - static_cast<U32>( _freeSlots.size() + _retiredSlots.size() );
+    }
+
+private:
+    struct RetiredSlot
+    {
+        BindlessIndex index {};
+        U64 frameNumber {};
+    };
+
+    U32 _capacity;
+    U32 _nextUnused { 0 };
+    std::pmr::vector<BindlessIndex> _freeSlots;
+    std::pmr::deque<RetiredSlot> _retiredSlots;
+};
+
+// One update-after-bind descriptor set holding every sampled image and storage buffer, bound once per command buffer.
+// Registering a resource writes its descriptor into a free slot, draws select resources by slot index through push
+// constants, so nothing is rebound per draw. Thread safe.
+struct VulkanBindlessDescriptors : public VulkanHandle
+{
+    VulkanBindlessDescriptors( VulkanDevice& device, vk::AllocationCallbacks* allocator,
+                               std::pmr::memory_resource* pResource );
+
+    void Initialize( U32 framesInFlight );
+    void Destroy() override;
+
+    // Called once the fence of the frame slot was waited on
+    void BeginFrame( U64 frameNumber );
+
+    [[nodiscard]] auto RegisterImage( const vk::ImageView& imageView,
+                                      vk::ImageLayout imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal )
+      -> BindlessIndex;
+    [[nodiscard]] auto RegisterBuffer( const vk::Buffer& buffer, vk::DeviceSize offset = 0,
+                                       vk::DeviceSize range = VK_WHOLE_SIZE ) -> BindlessIndex;
+    // The slot is reused once the frames in flight that may read it have completed
+    void ReleaseImage( BindlessIndex index );
+    void ReleaseBuffer( BindlessIndex index );
+
+    void Bind( const vk::CommandBuffer& commandBuffer, vk::PipelineBindPoint bindPoint ) const;
+
+    template <typename T> void PushConstants( const vk::CommandBuffer& commandBuffer, const T& constants ) const
+    {
+        static_assert( sizeof( T ) <= kBindlessPushConstantSize, "Push constants do not fit in the shared range." );
+        commandBuffer.pushConstants( _pipelineLayout, vk::ShaderStageFlagBits::eAll, 0, sizeof( T ), &constants );
+    }
+
+    [[nodiscard]] auto GetSetLayout() const -> const vk::DescriptorSetLayout&;
+    // Layout of kPassSetIndex, a single uniform buffer at binding 0
+    [[nodiscard]] auto GetPassSetLayout() const -> const vk::DescriptorSetLayout&;
+    // Shared by every pipeline, so binding a pipeline never disturbs the bindless set
+    [[nodiscard]] auto GetPipelineLayout() const -> const vk::PipelineLayout&;
+
+    void PrintStats() const;
+
+private:
+    void CreateSamplers();
+
+    vk::DescriptorPool _pool {};
+    vk::DescriptorSetLayout _setLayout {};
+    vk::DescriptorSetLayout _passSetLayout {};
+    vk::DescriptorSet _set {};
+    vk::PipelineLayout _pipelineLayout {};
+    std::array<vk::Sampler, static_cast<size_t>( BindlessSampler::COUNT )> _samplers {};
+
+    BindlessSlotAllocator _imageSlots;
+    BindlessSlotAllocator _bufferSlots;
+    U32 _framesInFlight { 1 };
+    U64 _frameNumber {};
+    mutable std::mutex _mutex;
+};
+
+}  // namespace WindEngine::Core::Render
+
+#endif  // WINDENGINE_VULKANBINDLESSDESCRIPTORS_HPP
@@ -12,7 +12,7 @@ VulkanBuffer::VulkanBuffer( VulkanDevice& device, vk::AllocationCallbacks* alloc
 void VulkanBuffer::Initialize( const VulkanBufferCreateInfo& vulkanBufferInfo )
 {
     auto sharingMode = vk::SharingMode::eExclusive;
-    if ( !vulkanBufferInfo.queueIndices.empty() && G_IS_VECTOR_UNIQUE( vulkanBufferInfo.queueIndices ) )
+    if ( !vulkanBufferInfo.queueIndices.empty() && G_ARE_VALUES_UNIQUE( vulkanBufferInfo.queueIndices ) )
     {
         sharingMode = vk::SharingMode::eConcurrent;
     }
@@ -26,19 +26,21 @@ void VulkanBuffer::Initialize( const VulkanBufferCreateInfo& vulkanBufferInfo )
     buffer = _device->device.createBuffer( bufferInfo, _allocator );
 
     _memoryRequirements = _device->device.getBufferMemoryRequirements( buffer );
-    const auto memoryIndex =
-      _device->physicalDeviceInfo.FindMemoryIndex( _memoryRequirements.memoryTypeBits, vulkanBufferInfo.memoryFlags );
-    const auto memoryInfo =
-      vk::MemoryAllocateInfo { .allocationSize = _memoryRequirements.size, .memoryTypeIndex = memoryIndex };
-    deviceMemory = _device->device.allocateMemory( memoryInfo, _allocator );
+    const auto memoryRequest = MemoryTypeRequest { .required = vulkanBufferInfo.memoryFlags,
+                                                   .preferred = vulkanBufferInfo.preferredMemoryFlags,
+                                                   .avoided = vulkanBufferInfo.avoidedMemoryFlags };
+    allocation = _device->memoryAllocator.Allocate( _memoryRequirements, memoryRequest, DeviceResourceKind::LINEAR );
 
-    _device->device.bindBufferMemory( buffer, deviceMemory, 0 );
+    _device->device.bindBufferMemory( buffer, allocation.memory, allocation.offset );
+    pMappedData = _device->memoryAllocator.GetMappedData( allocation );
 }
 
 void VulkanBuffer::Destroy()
 {
     _device->device.destroy( buffer, _allocator );
-    _device->device.free( deviceMemory, _allocator );
+    _device->memoryAllocator.Free( allocation );
+    allocation = {};
+    pMappedData = nullptr;
 }
 
 }  // namespace WindEngine::Core::Render
@@ -1,7 +1,9 @@
 #ifndef WINDENGINE_VULKANBUFFER_HPP
 #define WINDENGINE_VULKANBUFFER_HPP
 
+#include "assert.hpp"
 #include "vulkanHandle.hpp"
+#include <span>
 
 namespace WindEngine::Core::Render
 {
@@ -10,26 +12,31 @@ struct VulkanBufferCreateInfo
 {
     vk::DeviceSize size {};
     vk::BufferUsageFlags usageFlags {};
-    std::vector<U32> queueIndices {};
+    std::span<const U32> queueIndices {};
     vk::MemoryPropertyFlags memoryFlags {};
+    vk::MemoryPropertyFlags preferredMemoryFlags {};
+    vk::MemoryPropertyFlags avoidedMemoryFlags {};
 };
 
 struct VulkanBuffer : public VulkanHandle
 {
     vk::Buffer buffer {};
-    vk::DeviceMemory deviceMemory {};
+    VulkanAllocation allocation {};
+    // Set for host visible buffers, which stay mapped until Destroy
+    void* pMappedData { nullptr };
 
     VulkanBuffer( VulkanDevice& device, vk::AllocationCallbacks* allocator );
 
     void Initialize( const VulkanBufferCreateInfo& vulkanBufferInfo );
     void Destroy() override;
 
-    template <typename T> void MapMemory( const std::vector<T>& vec )
+    template <typename T> void WriteMemory( std::span<const T> data, vk::DeviceSize offset = 0 )
     {
-        const auto size = sizeof( T ) * vec.size();
-        auto* pData = static_cast<uint8_t*>( _device->device.mapMemory( deviceMemory, 0, _memoryRequirements.size ) );
-        memcpy( pData, vec.data(), size );
-        _device->device.unmapMemory( deviceMemory );
+        const auto size = data.size_bytes();
+        WindAssert( pMappedData != nullptr, "Only host visible buffers can be written directly." );
+        WindAssert( offset + size <= allocation.size, "Data does not fit in the buffer." );
+        memcpy( static_cast<std::byte*>( pMappedData ) + offset, data.data(), size );
+        _device->memoryAllocator.Flush( allocation, offset, size );
     }
 
 private:
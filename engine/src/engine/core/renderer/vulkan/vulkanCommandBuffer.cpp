@@ -27,6 +27,15 @@ void VulkanCommandBuffer::Begin() const
     commandBuffer.begin( beginInfo );
 }
 
+void VulkanCommandBuffer::Begin( const vk::CommandBufferInheritanceInfo& inheritanceInfo ) const
+{
+    const auto beginInfo = vk::CommandBufferBeginInfo {
+        .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit | vk::CommandBufferUsageFlagBits::eRenderPassContinue,
+        .pInheritanceInfo = &inheritanceInfo,
+    };
+    commandBuffer.begin( beginInfo );
+}
+
 void VulkanCommandBuffer::End() const
 {
     commandBuffer.end();
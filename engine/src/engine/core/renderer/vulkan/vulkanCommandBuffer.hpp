@@ -14,6 +14,8 @@ struct VulkanCommandBuffer
     void Free( const vk::Device& device, const vk::CommandPool& pool ) const;
 
     void Begin() const;
+    // Secondary buffers recorded inside the inherited render pass subpass
+    void Begin( const vk::CommandBufferInheritanceInfo& inheritanceInfo ) const;
     void End() const;
     void Reset() const;
 };
@@ -2,19 +2,35 @@
 #include "logger.hpp"
 #include "vulkanDevice.hpp"
 #include "vulkanInstance.hpp"
-#include "vulkanPipeline.hpp"
+#include "vulkanPipelineManager.hpp"
 
 namespace WindEngine::Core::Render
 {
 
-VulkanContext::VulkanContext()
-  : swapchain( device, allocator ), renderPass( device, allocator ), graphicsPipeline( device, allocator ),
-    triangleBuffer( device, allocator )
+VulkanContext::VulkanContext( Memory::AllocationManager& allocationManager )
+  : hostAllocator( allocationManager ), allocator( hostAllocator.GetCallbacks() ),
+    device( allocationManager.GetResource( Memory::AllocationType::RENDERER ) ), swapchain( device, allocator ),
+    renderPass( device, allocator ),
+    bindless( device, allocator, allocationManager.GetResource( Memory::AllocationType::RENDERER ) ),
+    descriptorAllocator( device, allocator, allocationManager.GetResource( Memory::AllocationType::RENDERER ) ),
+    pipelineCache( device, allocator ),
+    pipelineManager( device, allocator, workerPool, allocationManager.GetResource( Memory::AllocationType::RENDERER ) ),
+    parallelRecorder( device, allocator, recordPool,
+                      allocationManager.GetResource( Memory::AllocationType::RENDERER ) ),
+    uploader( device, allocator, allocationManager.GetResource( Memory::AllocationType::RENDERER ) ),
+    textureStreamer( device, allocator, uploader, bindless,
+                     allocationManager.GetResource( Memory::AllocationType::RENDERER ) ),
+    triangleBuffer( device, allocator ), uploadRing( device, allocator ),
+    framebuffers( allocationManager.GetResource( Memory::AllocationType::RENDERER ) ),
+    frames( allocationManager.GetResource( Memory::AllocationType::RENDERER ) )
 {
 }
 
-auto VulkanContext::Initialize( const char* applicationName, U32 width, U32 height ) -> bool
+auto VulkanContext::Initialize( const char* applicationName, U32 width, U32 height, U32 frameCount ) -> bool
 {
+    framesInFlight = frameCount;
+    WindInfo( "Running with {} frames in flight.", framesInFlight );
+
     window = SDL_CreateWindow( "WindEngine", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, static_cast<int>( width ),
                                static_cast<int>( height ), SDL_WINDOW_VULKAN | SDL_WINDOW_RESIZABLE );
     if ( window == nullptr )
@@ -36,40 +52,55 @@ auto VulkanContext::Initialize( const char* applicationName, U32 width, U32 heig
 
     swapchain.Initialize( surface, framebufferWidth, framebufferHeight );
     renderPass.Initialize( swapchain.imageFormat.format, device.depthFormat );
-    graphicsPipeline.Initialize( renderPass.GetRenderPass() );
-
-    // TODO(emreaydn): ? Abstract away
-    // Command pool and command buffers
-    const auto poolInfo = vk::CommandPoolCreateInfo {
-        .flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
-        .queueFamilyIndex = device.indices.graphics,
+    bindless.Initialize( framesInFlight );
+    descriptorAllocator.Initialize( framesInFlight );
+    pipelineCache.Initialize( std::filesystem::current_path() / kPipelineCacheFileName );
+    auto defaultDescription = VulkanPipelineDescription {
+        .vertexShader = "shaders/simple_vert.spv",
+        .fragmentShader = "shaders/simple_frag.spv",
+        .vertexBindingCount = 2,
+        .vertexAttributeCount = 2,
+        .renderPass = renderPass.GetRenderPass(),
     };
-    graphicsCommandPool = GetDevice().createCommandPool( poolInfo, allocator );
-    graphicsCommandBuffers.resize( swapchain.imageCount );
-    for ( auto& buffer : graphicsCommandBuffers )
-    {
-        buffer.Allocate( GetDevice(), graphicsCommandPool, true );
-    }
-    WindInfo( "Allocated {} graphics command buffers.", graphicsCommandBuffers.size() );
+    // Positions come from the static vertex buffer, colors from the upload ring where they are rewritten every frame
+    defaultDescription.vertexBindings[0] = { .binding = 0,
+                                             .stride = sizeof( Vertex ),
+                                             .inputRate = vk::VertexInputRate::eVertex };
+    defaultDescription.vertexBindings[1] = { .binding = 1,
+                                             .stride = sizeof( glm::vec3 ),
+                                             .inputRate = vk::VertexInputRate::eVertex };
+    defaultDescription.vertexAttributes[0] = {
+        .location = 0, .binding = 0, .format = vk::Format::eR32G32B32Sfloat, .offset = offsetof( Vertex, pos )
+    };
+    defaultDescription.vertexAttributes[1] = {
+        .location = 1, .binding = 1, .format = vk::Format::eR32G32B32Sfloat, .offset = 0
+    };
+    pipelineManager.Initialize( defaultDescription, bindless.GetPipelineLayout(), pipelineCache.GetPipelineCache() );
+    // Deduplicates to the default pipeline for now, materials with their own shaders compile in the background
+    trianglePipeline = pipelineManager.Request( defaultDescription );
+    parallelRecorder.Initialize( framesInFlight );
+    uploader.Initialize();
+    textureStreamer.Initialize( kDefaultTextureBudget );
+    sampleTexture = textureStreamer.Load( kSampleTexturePath );
 
     RecreateFramebuffers( width, height );
 
-    // TODO(emreaydn): Move from here
-    for ( auto& frame : frames )
+    frames.reserve( framesInFlight );
+    for ( U32 ind = 0; ind < framesInFlight; ++ind )
     {
-        const auto fenceInfo = vk::FenceCreateInfo {
-            .flags = vk::FenceCreateFlagBits::eSignaled,
-        };
-        frame.renderSemaphore = GetDevice().createSemaphore( {}, allocator );
-        frame.presentSemaphore = GetDevice().createSemaphore( {}, allocator );
-        frame.fence = GetDevice().createFence( fenceInfo, allocator );
+        frames.emplace_back( frames.get_allocator().resource() ).Initialize( GetDevice(), device.indices.graphics,
+                                                                               allocator );
     }
 
     triangleBuffer.Initialize(
       { .size = sizeof( Vertex ) * 3,
-        .usageFlags = vk::BufferUsageFlagBits::eVertexBuffer,
-        .memoryFlags = vk::MemoryPropertyFlagBits::eHostCoherent | vk::MemoryPropertyFlagBits::eHostVisible } );
-    triangleBuffer.MapMemory( triangle );
+        .usageFlags = vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eTransferDst,
+        .memoryFlags = vk::MemoryPropertyFlagBits::eDeviceLocal,
+        .avoidedMemoryFlags = vk::MemoryPropertyFlagBits::eHostVisible } );
+    uploader.UploadBuffer( triangleBuffer, std::as_bytes( std::span( triangle ) ), 0,
+                           vk::PipelineStageFlagBits::eVertexInput, vk::AccessFlagBits::eVertexAttributeRead );
+
+    uploadRing.Initialize( kUploadRingFrameSize, framesInFlight );
 
     return true;
 }
@@ -78,35 +109,45 @@ void VulkanContext::Shutdown()
 {
     GetDevice().waitIdle();
 
-    triangleBuffer.Destroy();
-
-    for ( const auto& frame : frames )
+    // First, objects in the deletion queues may depend on anything below
+    for ( auto& frame : frames )
     {
-        GetDevice().destroy( frame.renderSemaphore, allocator );
-        GetDevice().destroy( frame.presentSemaphore, allocator );
-        GetDevice().destroy( frame.fence, allocator );
+        frame.Destroy( GetDevice(), allocator );
     }
+    frames.clear();
+
+    triangleBuffer.Destroy();
+    uploadRing.Destroy();
+    textureStreamer.PrintStats();
+    textureStreamer.Destroy();
+    uploader.Destroy();
 
     for ( const auto& buffer : framebuffers )
     {
         GetDevice().destroy( buffer, allocator );
     }
 
-    for ( const auto& buffer : graphicsCommandBuffers )
-    {
-        buffer.Free( GetDevice(), graphicsCommandPool );
-    }
-    GetDevice().destroy( graphicsCommandPool, allocator );
-
-    graphicsPipeline.Destroy();
+    parallelRecorder.PrintStats();
+    parallelRecorder.Destroy();
+
+    pipelineManager.PrintStats();
+    pipelineManager.Destroy();
+    pipelineCache.Save();
+    pipelineCache.Destroy();
+    bindless.PrintStats();
+    bindless.Destroy();
+    descriptorAllocator.PrintStats();
+    descriptorAllocator.Destroy();
     renderPass.Destroy();
     swapchain.Destroy();
 
-    device.Destroy();
+    device.Destroy( allocator );
 
+    // SDL creates the surface without allocation callbacks
     GetInstance().destroy( surface );
 
     instance.Destroy( allocator );
+    hostAllocator.PrintStats();
 
     SDL_DestroyWindow( window );
 }
@@ -126,9 +167,14 @@ auto VulkanContext::GetSwapchain() const -> const vk::SwapchainKHR&
     return swapchain.swapchain;
 }
 
-auto VulkanContext::GetCurrentFrame() -> Frame&
+auto VulkanContext::GetCurrentFrame() -> FrameResources&
+{
+    return frames.at( GetCurrentFrameIndex() );
+}
+
+auto VulkanContext::GetCurrentFrameIndex() const -> U32
 {
-    return frames.at( currentFrame % kFramesInFlight );
+    return ToU32( currentFrame % framesInFlight );
 }
 
 void VulkanContext::RecreateFramebuffers( U32 width, U32 height )
@@ -143,7 +189,7 @@ void VulkanContext::RecreateFramebuffers( U32 width, U32 height )
     framebuffers.resize( swapchain.imageCount );
     for ( size_t ind = 0; ind < framebuffers.size(); ++ind )
     {
-        auto attachments = std::vector<vk::ImageView> { swapchain.imageViews[ind], swapchain.depthImage.imageView };
+        const auto attachments = std::array { swapchain.imageViews[ind], swapchain.depthImage.imageView };
         const auto framebufferInfo = vk::FramebufferCreateInfo { .renderPass = renderPass.GetRenderPass(),
                                                                  .attachmentCount = ToU32( attachments.size() ),
                                                                  .pAttachments = attachments.data(),
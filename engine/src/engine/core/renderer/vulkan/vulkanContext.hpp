@@ -1,19 +1,33 @@
 #ifndef WINDENGINE_VULKANCONTEXT_HPP
 #define WINDENGINE_VULKANCONTEXT_HPP
 
+#include "allocationManager.hpp"
+#include "appConfig.h"
+#include "threadPool.hpp"
+#include "vulkanBindlessDescriptors.hpp"
 #include "vulkanBuffer.hpp"
 #include "vulkanCommandBuffer.hpp"
+#include "vulkanDescriptorAllocator.hpp"
 #include "vulkanDevice.hpp"
+#include "vulkanFrameResources.hpp"
+#include "vulkanHostAllocator.hpp"
 #include "vulkanInstance.hpp"
-#include "vulkanPipeline.hpp"
+#include "vulkanParallelRecorder.hpp"
+#include "vulkanPipelineCache.hpp"
+#include "vulkanPipelineManager.hpp"
 #include "vulkanRenderPass.hpp"
 #include "vulkanSwapchain.hpp"
+#include "vulkanTextureStreamer.hpp"
+#include "vulkanUploadRing.hpp"
+#include "vulkanUploader.hpp"
 #include <SDL_vulkan.h>
+#include <memory_resource>
 #include <vulkan/vulkan.hpp>
 
 struct Vertex
 {
     glm::vec3 pos;
+    // Base color, the renderer scales it every frame and streams the result through the upload ring
     glm::vec3 col;
 };
 
@@ -26,50 +40,57 @@ const auto triangle = std::vector<Vertex> {
 namespace WindEngine::Core::Render
 {
 
-struct Frame
-{
-    vk::Semaphore renderSemaphore;
-    vk::Semaphore presentSemaphore;
-    vk::Fence fence;
-};
-
-// TODO(emreaydn): Configurable?
-constexpr U32 kFramesInFlight = 2;
+constexpr const char* kSampleTexturePath = "textures/checker.wtex";
 
 struct VulkanContext
 {
     SDL_Window* window { nullptr };
+    VulkanHostAllocator hostAllocator;
     vk::AllocationCallbacks* allocator { nullptr };
     vk::SurfaceKHR surface { nullptr };
+    // Background work such as pipeline compiles
+    ThreadPool workerPool;
+    // Only records command buffers, so a frame never waits behind the background work
+    ThreadPool recordPool;
 
     VulkanInstance instance {};
-    VulkanDevice device {};
+    VulkanDevice device;
     VulkanSwapchain swapchain;
     VulkanRenderPass renderPass;
-    std::vector<VulkanCommandBuffer> graphicsCommandBuffers;
-    vk::CommandPool graphicsCommandPool;
-    VulkanPipeline graphicsPipeline;
+    VulkanBindlessDescriptors bindless;
+    VulkanDescriptorAllocator descriptorAllocator;
+    VulkanPipelineCache pipelineCache;
+    VulkanPipelineManager pipelineManager;
+    VulkanParallelRecorder parallelRecorder;
+    VulkanUploader uploader;
+    VulkanTextureStreamer textureStreamer;
 
     // Temp
     VulkanBuffer triangleBuffer;
+    VulkanUploadRing uploadRing;
+    PipelineHandle trianglePipeline { kDefaultPipelineHandle };
+    TextureHandle sampleTexture {};
 
-    std::vector<vk::Framebuffer> framebuffers;
+    std::pmr::vector<vk::Framebuffer> framebuffers;
     U32 framebufferWidth {};
     U32 framebufferHeight {};
 
     USize imageIndex {};
     USize currentFrame {};
-    std::array<Frame, kFramesInFlight> frames {};
+    U32 framesInFlight { kDefaultFramesInFlight };
+    // Indexed by currentFrame % framesInFlight, independent of the swapchain image count
+    std::pmr::vector<FrameResources> frames;
 
-    VulkanContext();
+    explicit VulkanContext( Memory::AllocationManager& allocationManager );
 
-    auto Initialize( const char* applicationName, U32 width, U32 height ) -> bool;
+    auto Initialize( const char* applicationName, U32 width, U32 height, U32 frameCount ) -> bool;
     void Shutdown();
 
     [[nodiscard]] auto GetInstance() const -> const vk::Instance&;
     [[nodiscard]] auto GetDevice() const -> const vk::Device&;
     [[nodiscard]] auto GetSwapchain() const -> const vk::SwapchainKHR&;
-    [[nodiscard]] auto GetCurrentFrame() -> Frame&;
+    [[nodiscard]] auto GetCurrentFrame() -> FrameResources&;
+    [[nodiscard]] auto GetCurrentFrameIndex() const -> U32;
 
     void RecreateFramebuffers( U32 width, U32 height );
 };
@@ -0,0 +1,133 @@
+#include "vulkanDescriptorAllocator.hpp"
+#include "logger.hpp"
+#include <algorithm>
+
+namespace WindEngine::Core::Render
+{
+
+VulkanDescriptorAllocator::VulkanDescriptorAllocator( VulkanDevice& device, vk::AllocationCallbacks* allocator,
+                                                      std::pmr::memory_resource* pResource )
+  : VulkanHandle( &device, allocator ), _pResource( pResource ), _framePools( pResource ), _freePools( pResource )
+{
+}
+
+void VulkanDescriptorAllocator::Initialize( U32 frameCount )
+{
+    _framePools.clear();
+    for ( U32 ind = 0; ind < frameCount; ++ind )
+    {
+        _framePools.emplace_back( _pResource );
+    }
+    _frameIndex = 0;
+}
+
+void VulkanDescriptorAllocator::Destroy()
+{
+    const std::scoped_lock lock( _mutex );
+    for ( const auto& pools : _framePools )
+    {
+        for ( const auto& pool : pools )
+        {
+            _device->device.destroy( pool, _allocator );
+        }
+    }
+    for ( const auto& pool : _freePools )
+    {
+        _device->device.destroy( pool, _allocator );
+    }
+    _framePools.clear();
+    _freePools.clear();
+}
+
+void VulkanDescriptorAllocator::BeginFrame( U32 frameIndex )
+{
+    const std::scoped_lock lock( _mutex );
+    _frameIndex = frameIndex;
+    _frameSetCount = 0;
+
+    // Resetting a pool returns every set allocated from it in one call
+    auto& pools = _framePools.at( frameIndex );
+    for ( const auto& pool : pools )
+    {
+        _device->device.resetDescriptorPool( pool );
+        _freePools.push_back( pool );
+    }
+    pools.clear();
+}
+
+auto VulkanDescriptorAllocator::Allocate( const vk::DescriptorSetLayout& setLayout ) -> vk::DescriptorSet
+{
+    const std::scoped_lock lock( _mutex );
+    auto& pools = _framePools.at( _frameIndex );
+    if ( pools.empty() )
+    {
+        pools.push_back( AcquirePool() );
+    }
+
+    auto setInfo = vk::DescriptorSetAllocateInfo { .descriptorPool = pools.back(),
+                                                   .descriptorSetCount = 1,
+                                                   .pSetLayouts = &setLayout };
+    vk::DescriptorSet set {};
+    auto result = _device->device.allocateDescriptorSets( &setInfo, &set );
+    if ( result == vk::Result::eErrorOutOfPoolMemory || result == vk::Result::eErrorFragmentedPool )
+    {
+        // The current pool is full, move on to a fresh one
+        pools.push_back( AcquirePool() );
+        setInfo.descriptorPool = pools.back();
+        result = _device->device.allocateDescriptorSets( &setInfo, &set );
+    }
+    if ( result != vk::Result::eSuccess )
+    {
+        WindFatal( "Failed to allocate a descriptor set. {}", vk::to_string( result ) );
+    }
+
+    ++_frameSetCount;
+    _peakFrameSetCount = std::max( _peakFrameSetCount, _frameSetCount );
+    return set;
+}
+
+auto VulkanDescriptorAllocator::GetPoolCount() const -> size_t
+{
+    const std::scoped_lock lock( _mutex );
+    auto count = _freePools.size();
+    for ( const auto& pools : _framePools )
+    {
+        count += pools.size();
+    }
+    return count;
+}
+
+void VulkanDescriptorAllocator::PrintStats() const
+{
+    const auto poolCount = GetPoolCount();
+    const std::scoped_lock lock( _mutex );
+    WindDebug( "[[Descriptor Pools]]" );
+    WindDebug( "\tPools: {} - Free: {} - Peak Sets Per Frame: {}", poolCount, _freePools.size(), _peakFrameSetCount );
+}
+
+auto VulkanDescriptorAllocator::AcquirePool() -> vk::DescriptorPool
+{
+    if ( !_freePools.empty() )
+    {
+        const auto pool = _freePools.back();
+        _freePools.pop_back();
+        return pool;
+    }
+
+    auto poolSizes = std::array<vk::DescriptorPoolSize, kDescriptorPoolRatios.size()> {};
+    for ( size_t ind = 0; ind < kDescriptorPoolRatios.size(); ++ind )
+    {
+        poolSizes[ind] = { .type = kDescriptorPoolRatios[ind].type,
+                           .descriptorCount =
+                             static_cast<U32>( kDescriptorPoolRatios[ind].perSet * kDescriptorPoolMaxSets ) };
+    }
+    // No free bit, sets are only ever released by resetting the pool
+    const auto poolInfo = vk::DescriptorPoolCreateInfo { .flags = {},
+                                                         .maxSets = kDescriptorPoolMaxSets,
+                                                         .poolSizeCount = ToU32( poolSizes.size() ),
+                                                         .pPoolSizes = poolSizes.data() };
+    WindTrace( "Created descriptor pool for frame slot {}.", _frameIndex );
+    return _device->device.createDescriptorPool( poolInfo, _allocator );
+}
+
+}  // namespace WindEngine::Core::Render
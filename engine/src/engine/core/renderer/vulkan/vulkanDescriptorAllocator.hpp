@@ -0,0 +1,64 @@
+#ifndef WINDENGINE_VULKANDESCRIPTORALLOCATOR_HPP
+#define WINDENGINE_VULKANDESCRIPTORALLOCATOR_HPP
+
+#include "vulkanHandle.hpp"
+#include <array>
+#include <memory_resource>
+#include <mutex>
+
+namespace WindEngine::Core::Render
+{
+
+constexpr U32 kDescriptorPoolMaxSets = 256;
+
+// Descriptors per set each pool is sized for, by type
+struct DescriptorPoolRatio
+{
+    vk::DescriptorType type {};
+    F32 perSet {};
+};
+
+constexpr auto kDescriptorPoolRatios = std::array {
+    DescriptorPoolRatio { .type = vk::DescriptorType::eUniformBuffer, .perSet = 2.0F },
+    DescriptorPoolRatio { .type = vk::DescriptorType::eUniformBufferDynamic, .perSet = 1.0F },
+    DescriptorPoolRatio { .type = vk::DescriptorType::eCombinedImageSampler, .perSet = 2.0F },
+    DescriptorPoolRatio { .type = vk::DescriptorType::eStorageBuffer, .perSet = 1.0F },
+    DescriptorPoolRatio { .type = vk::DescriptorType::eStorageImage, .perSet = 0.5F },
+};
+
+// Transient descriptor sets for data that does not go through the bindless set, such as per-pass uniforms. Sets are
+// allocated linearly from the pools of the current frame and are never freed one by one, instead every pool of a
+// frame slot is reset at once when that slot comes around again. Thread safe.
+struct VulkanDescriptorAllocator : public VulkanHandle
+{
+    VulkanDescriptorAllocator( VulkanDevice& device, vk::AllocationCallbacks* allocator,
+                               std::pmr::memory_resource* pResource );
+
+    void Initialize( U32 frameCount );
+    void Destroy() override;
+
+    // Has to be called after the fence of the frame slot was waited on
+    void BeginFrame( U32 frameIndex );
+
+    // Valid until the frame slot comes around again
+    [[nodiscard]] auto Allocate( const vk::DescriptorSetLayout& setLayout ) -> vk::DescriptorSet;
+
+    [[nodiscard]] auto GetPoolCount() const -> size_t;
+    void PrintStats() const;
+
+private:
+    [[nodiscard]] auto AcquirePool() -> vk::DescriptorPool;
+
+    std::pmr::memory_resource* _pResource;
+    // Pools handed to each frame slot, the last one is the one being allocated from
+    std::pmr::vector<std::pmr::vector<vk::DescriptorPool>> _framePools;
+    std::pmr::vector<vk::DescriptorPool> _freePools;
+    U32 _frameIndex { 0 };
+    size_t _frameSetCount { 0 };
+    size_t _peakFrameSetCount { 0 };
+    mutable std::mutex _mutex;
+};
+
+}  // namespace WindEngine::Core::Render
+
+#endif  // WINDENGINE_VULKANDESCRIPTORALLOCATOR_HPP
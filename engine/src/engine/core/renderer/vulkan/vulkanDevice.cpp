@@ -2,6 +2,7 @@
 #include "assert.hpp"
 #include "logger.hpp"
 #include <algorithm>
+#include <bit>
 #include <ranges>
 
 // Check for required device extensions
@@ -12,23 +13,68 @@ static constexpr const std::array<const char*, 2> kRequiredExtensions { "VK_KHR_
 static std::vector<const char*> kRequiredExtensions { "VK_KHR_swapchain" };
 #endif
 
+// Without resizable BAR only this much of VRAM is host visible
+static constexpr vk::DeviceSize kBarWindowSize = 256 * 1024 * 1024;
+
 namespace WindEngine::Core::Render
 {
 
-auto PhysicalDeviceInfo::FindMemoryIndex( U32 memoryTypeBits, vk::MemoryPropertyFlags requiredFlags ) const -> U32
+auto PhysicalDeviceInfo::FindMemoryIndex( U32 memoryTypeBits, const MemoryTypeRequest& request ) const
+  -> std::optional<U32>
 {
-    for ( size_t ind = 0; ind < memory.memoryTypeCount; ++ind )
+    const auto countFlags = []( vk::MemoryPropertyFlags flags ) {
+        return std::popcount( static_cast<VkMemoryPropertyFlags>( flags ) );
+    };
+    const auto getHeapSize = [this]( U32 memoryIndex ) {
+        return memory.memoryHeaps[memory.memoryTypes[memoryIndex].heapIndex].size;
+    };
+    constexpr auto kAvoidedFlagCost = 32;
+
+    std::optional<U32> bestIndex {};
+    auto bestScore = 0;
+    for ( U32 ind = 0; ind < memory.memoryTypeCount; ++ind )
     {
-        const auto isRequiredMemoryType = ( memoryTypeBits & ( 1 << ind ) ) != 0U;
+        const auto isRequiredMemoryType = ( memoryTypeBits & ( 1U << ind ) ) != 0U;
         const auto propertyFlags = memory.memoryTypes[ind].propertyFlags;
-        const auto hasRequiredProperties = ( propertyFlags & requiredFlags ) == requiredFlags;
+        const auto hasRequiredProperties = ( propertyFlags & request.required ) == request.required;
+        if ( !isRequiredMemoryType || !hasRequiredProperties )
+        {
+            continue;
+        }
+
+        const auto score = countFlags( propertyFlags & request.preferred ) -
+                           countFlags( propertyFlags & request.avoided ) * kAvoidedFlagCost;
+        const auto isLargerHeap = bestIndex.has_value() && getHeapSize( ind ) > getHeapSize( *bestIndex );
+        if ( !bestIndex.has_value() || score > bestScore || ( score == bestScore && isLargerHeap ) )
+        {
+            bestIndex = ind;
+            bestScore = score;
+        }
+    }
+    return bestIndex;
+}
 
-        if ( isRequiredMemoryType && hasRequiredProperties )
+auto PhysicalDeviceInfo::HasResizableBar() const -> bool
+{
+    constexpr auto kBarFlags = vk::MemoryPropertyFlagBits::eDeviceLocal | vk::MemoryPropertyFlagBits::eHostVisible;
+    for ( U32 ind = 0; ind < memory.memoryTypeCount; ++ind )
+    {
+        const auto& memoryType = memory.memoryTypes[ind];
+        if ( ( memoryType.propertyFlags & kBarFlags ) == kBarFlags &&
+             memory.memoryHeaps[memoryType.heapIndex].size > kBarWindowSize )
         {
-            return ind;
+            return true;
         }
     }
-    WindFatal( "Failed to find a suitable memory index." );
+    return false;
+}
+
+VulkanDevice::VulkanDevice( std::pmr::memory_resource* pResource )
+  : swapchainSupportInfo { .presentModes = std::pmr::vector<vk::PresentModeKHR>( pResource ),
+                           .surfaceCapabilities = {},
+                           .surfaceFormats = std::pmr::vector<vk::SurfaceFormatKHR>( pResource ) },
+    memoryAllocator( *this, pResource )
+{
 }
 
 auto VulkanDevice::Initialize( const vk::Instance& instance, const vk::SurfaceKHR& surface,
@@ -44,9 +90,11 @@ auto VulkanDevice::Initialize( const vk::Instance& instance, const vk::SurfaceKH
     return true;
 }
 
-void VulkanDevice::Destroy() const
+void VulkanDevice::Destroy( const vk::AllocationCallbacks* allocator )
 {
-    device.destroy();
+    memoryAllocator.PrintStats();
+    memoryAllocator.Destroy();
+    device.destroy( allocator );
 }
 
 auto VulkanDevice::AreGraphicsAndPresentSharing() const -> bool
@@ -56,26 +104,47 @@ auto VulkanDevice::AreGraphicsAndPresentSharing() const -> bool
 
 void VulkanDevice::QueryForSwapchainSupportInfo( const vk::SurfaceKHR& surface )
 {
-    swapchainSupportInfo = {
-        .presentModes = physicalDevice.getSurfacePresentModesKHR( surface ),
-        .surfaceCapabilities = physicalDevice.getSurfaceCapabilitiesKHR( surface ),
-        .surfaceFormats = physicalDevice.getSurfaceFormatsKHR( surface ),
-    };
+    // Query with the allocators of the existing vectors so the results are moved in without a copy
+    auto presentModeAllocator = swapchainSupportInfo.presentModes.get_allocator();
+    auto surfaceFormatAllocator = swapchainSupportInfo.surfaceFormats.get_allocator();
+    swapchainSupportInfo.presentModes = physicalDevice.getSurfacePresentModesKHR( surface, presentModeAllocator );
+    swapchainSupportInfo.surfaceCapabilities = physicalDevice.getSurfaceCapabilitiesKHR( surface );
+    swapchainSupportInfo.surfaceFormats = physicalDevice.getSurfaceFormatsKHR( surface, surfaceFormatAllocator );
 }
 
 auto VulkanDevice::InitializePhysicalDevice( const vk::Instance& instance, const vk::SurfaceKHR& surface ) -> bool
 {
+    const auto getTypeRank = []( const vk::PhysicalDevice& device ) {
+        switch ( device.getProperties().deviceType )
+        {
+        case vk::PhysicalDeviceType::eDiscreteGpu:
+            return 0;
+        case vk::PhysicalDeviceType::eIntegratedGpu:
+            return 1;
+        default:
+            return 2;
+        }
+    };
+
     const auto& physicalDevices = instance.enumeratePhysicalDevices();
     auto suitableDevices =
       physicalDevices |
-      std::views::filter( [&surface]( const auto& device ) { return IsPhysicalDeviceSuitable( device, surface ); } ) |
-      std::views::take( 1 );
-    if ( !suitableDevices.empty() )
+      std::views::filter( [&surface]( const auto& device ) { return IsPhysicalDeviceSuitable( device, surface ); } );
+    const auto bestDevice = std::ranges::min_element( suitableDevices, {}, getTypeRank );
+    if ( bestDevice != suitableDevices.end() )
     {
-        physicalDevice = physicalDevices.at( 0 );
+        physicalDevice = *bestDevice;
+        const auto features =
+          physicalDevice.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features>();
         physicalDeviceInfo = { .features = physicalDevice.getFeatures(),
+                               .features12 = features.get<vk::PhysicalDeviceVulkan12Features>(),
                                .memory = physicalDevice.getMemoryProperties(),
                                .properties = physicalDevice.getProperties() };
+        physicalDeviceInfo.features12.pNext = nullptr;
+        physicalDeviceInfo.supportsMemoryBudget =
+          std::ranges::any_of( physicalDevice.enumerateDeviceExtensionProperties(), []( const auto& extension ) {
+              return strcmp( extension.extensionName, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME ) == 0;
+          } );
         QueryForSwapchainSupportInfo( surface );
 
         indices = FindSuitableQueueFamilyIndices( physicalDevice, surface );
@@ -91,6 +160,8 @@ auto VulkanDevice::InitializePhysicalDevice( const vk::Instance& instance, const
                       static_cast<double>( memoryHeap.size ) / 1024.0 / 1024.0 / 1024.0,
                       vk::to_string( memoryHeap.flags ) );
         }
+        WindInfo( "Memory Budget: {} - Resizable BAR: {}", physicalDeviceInfo.supportsMemoryBudget,
+                  physicalDeviceInfo.HasResizableBar() );
         return true;
     }
     return false;
@@ -98,27 +169,47 @@ auto VulkanDevice::InitializePhysicalDevice( const vk::Instance& instance, const
 
 void VulkanDevice::InitializeDevice( const vk::AllocationCallbacks* allocator )
 {
+    // A family may serve several roles but can only be listed once, and only the first queue of each is used
     const std::array<F32, 1> queuePriorities { 1.0F };
-    const auto makeQueueInfo = [&]( U32 queueIndex ) {
-        const auto queueFamilyProps = physicalDevice.getQueueFamilyProperties()[queueIndex];
-        return vk::DeviceQueueCreateInfo { .queueFamilyIndex = queueIndex,
-                                           .queueCount = queueFamilyProps.queueCount,
-                                           .pQueuePriorities = queuePriorities.data() };
-    };
-    std::vector<vk::DeviceQueueCreateInfo> queueInfos { makeQueueInfo( indices.graphics ),
-                                                        makeQueueInfo( indices.compute ),
-                                                        makeQueueInfo( indices.transfer ),
-                                                        makeQueueInfo( indices.present ) };
+    std::vector<vk::DeviceQueueCreateInfo> queueInfos;
+    for ( const auto queueIndex : { indices.graphics, indices.compute, indices.transfer, indices.present } )
+    {
+        if ( std::ranges::none_of( queueInfos,
+                                   [queueIndex]( const auto& info ) { return info.queueFamilyIndex == queueIndex; } ) )
+        {
+            queueInfos.push_back( { .queueFamilyIndex = queueIndex,
+                                    .queueCount = ToU32( queuePriorities.size() ),
+                                    .pQueuePriorities = queuePriorities.data() } );
+        }
+    }
 
+    auto enabledExtensions = std::vector<const char*>( kRequiredExtensions.begin(), kRequiredExtensions.end() );
+    if ( physicalDeviceInfo.supportsMemoryBudget )
+    {
+        enabledExtensions.push_back( VK_EXT_MEMORY_BUDGET_EXTENSION_NAME );
+    }
+
+    const auto features12 =
+      vk::PhysicalDeviceVulkan12Features { .descriptorIndexing = VK_TRUE,
+                                           .shaderSampledImageArrayNonUniformIndexing = VK_TRUE,
+                                           .shaderStorageBufferArrayNonUniformIndexing = VK_TRUE,
+                                           .descriptorBindingSampledImageUpdateAfterBind = VK_TRUE,
+                                           .descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE,
+                                           .descriptorBindingUpdateUnusedWhilePending = VK_TRUE,
+                                           .descriptorBindingPartiallyBound = VK_TRUE,
+                                           .runtimeDescriptorArray = VK_TRUE,
+                                           .timelineSemaphore = VK_TRUE };
     const auto deviceInfo = vk::DeviceCreateInfo {
+        .pNext = &features12,
         .queueCreateInfoCount = ToU32( queueInfos.size() ),
         .pQueueCreateInfos = queueInfos.data(),
-        .enabledExtensionCount = ToU32( kRequiredExtensions.size() ),
-        .ppEnabledExtensionNames = kRequiredExtensions.data(),
+        .enabledExtensionCount = ToU32( enabledExtensions.size() ),
+        .ppEnabledExtensionNames = enabledExtensions.data(),
         //                             .pEnabledFeatures = &physicalDeviceInfo.features  // TODO: Do not enable all
     };
     device = physicalDevice.createDevice( deviceInfo, allocator );
     VULKAN_HPP_DEFAULT_DISPATCHER.init( device );
+    memoryAllocator.Initialize( allocator );
 
     graphicsQueue = device.getQueue( indices.graphics, 0 );
     computeQueue = device.getQueue( indices.compute, 0 );
@@ -131,10 +222,12 @@ auto VulkanDevice::IsPhysicalDeviceSuitable( const vk::PhysicalDevice& physicalD
 {
     // Check Device Types
     const auto& pdProps = physicalDevice.getProperties();
+    // Software implementations are accepted so the renderer can run on machines without a GPU
     if ( pdProps.deviceType != vk::PhysicalDeviceType::eDiscreteGpu &&
-         pdProps.deviceType != vk::PhysicalDeviceType::eIntegratedGpu )
+         pdProps.deviceType != vk::PhysicalDeviceType::eIntegratedGpu &&
+         pdProps.deviceType != vk::PhysicalDeviceType::eCpu )
     {
-        WindError( "{} is not discrete or integrated.", std::string_view( pdProps.deviceName ) );
+        WindError( "{} is not discrete, integrated or a CPU implementation.", std::string_view( pdProps.deviceName ) );
         return false;
     }
 
@@ -156,6 +249,31 @@ auto VulkanDevice::IsPhysicalDeviceSuitable( const vk::PhysicalDevice& physicalD
         return false;
     }
 
+    // Upload completion is tracked with a timeline semaphore
+    const auto features =
+      physicalDevice.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features>();
+    const auto& features12 = features.get<vk::PhysicalDeviceVulkan12Features>();
+    if ( features12.timelineSemaphore != VK_TRUE )
+    {
+        WindError( "{} does not support timeline semaphores.", std::string_view( pdProps.deviceName ) );
+        return false;
+    }
+
+    // Textures and buffers are bound through one update-after-bind descriptor set
+    const auto supportsBindless =
+      features12.descriptorIndexing == VK_TRUE && features12.runtimeDescriptorArray == VK_TRUE &&
+      features12.shaderSampledImageArrayNonUniformIndexing == VK_TRUE &&
+      features12.shaderStorageBufferArrayNonUniformIndexing == VK_TRUE &&
+      features12.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE &&
+      features12.descriptorBindingStorageBufferUpdateAfterBind == VK_TRUE &&
+      features12.descriptorBindingUpdateUnusedWhilePending == VK_TRUE &&
+      features12.descriptorBindingPartiallyBound == VK_TRUE;
+    if ( !supportsBindless )
+    {
+        WindError( "{} does not support bindless descriptor indexing.", std::string_view( pdProps.deviceName ) );
+        return false;
+    }
+
     // Check Queue Family Support
     bool supportsPresent { false };
     bool supportsGraphics { false };
@@ -2,6 +2,9 @@
 #define WINDENGINE_VULKANDEVICE_HPP
 
 #include "defines.hpp"
+#include "vulkanDeviceAllocator.hpp"
+#include <memory_resource>
+#include <optional>
 #include <vulkan/vulkan.hpp>
 
 namespace WindEngine::Core::Render
@@ -21,17 +24,23 @@ struct QueueFamilyIndices
 struct PhysicalDeviceInfo
 {
     vk::PhysicalDeviceFeatures features {};
+    vk::PhysicalDeviceVulkan12Features features12 {};
     vk::PhysicalDeviceMemoryProperties memory {};
     vk::PhysicalDeviceProperties properties {};
+    bool supportsMemoryBudget {};
 
-    [[nodiscard]] auto FindMemoryIndex( U32 memoryTypeBits, vk::MemoryPropertyFlags requiredFlags ) const -> U32;
+    // Best scoring memory type in memoryTypeBits, ties go to the type on the larger heap
+    [[nodiscard]] auto FindMemoryIndex( U32 memoryTypeBits, const MemoryTypeRequest& request ) const
+      -> std::optional<U32>;
+    // Whether the CPU can map all of VRAM rather than the 256 MiB window
+    [[nodiscard]] auto HasResizableBar() const -> bool;
 };
 
 struct SwapchainSupportInfo
 {
-    std::vector<vk::PresentModeKHR> presentModes;
+    std::pmr::vector<vk::PresentModeKHR> presentModes;
     vk::SurfaceCapabilitiesKHR surfaceCapabilities {};
-    std::vector<vk::SurfaceFormatKHR> surfaceFormats;
+    std::pmr::vector<vk::SurfaceFormatKHR> surfaceFormats;
 };
 
 struct VulkanDevice
@@ -48,10 +57,13 @@ struct VulkanDevice
     PhysicalDeviceInfo physicalDeviceInfo {};
     SwapchainSupportInfo swapchainSupportInfo {};
     vk::Format depthFormat {};
+    VulkanDeviceAllocator memoryAllocator;
+
+    explicit VulkanDevice( std::pmr::memory_resource* pResource );
 
     [[nodiscard]] auto Initialize( const vk::Instance& instance, const vk::SurfaceKHR& surface,
                                    const vk::AllocationCallbacks* allocator ) -> bool;
-    void Destroy() const;
+    void Destroy( const vk::AllocationCallbacks* allocator );
 
     [[nodiscard]] auto AreGraphicsAndPresentSharing() const -> bool;
     void QueryForSwapchainSupportInfo( const vk::SurfaceKHR& surface );
@@ -0,0 +1,387 @@
+#include "vulkanDeviceAllocator.hpp"
+#include "assert.hpp"
+#include "logger.hpp"
+#include "memoryUtils.hpp"
+#include "vulkanDevice.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace WindEngine::Core::Render
+{
+
+static auto GetBlockKindName( const VulkanMemoryBlock& block ) -> const char*
+{
+    if ( block.isDedicated )
+    {
+        return "Dedicated";
+    }
+    return block.kind == DeviceResourceKind::LINEAR ? "Linear" : "Optimal";
+}
+
+VulkanDeviceAllocator::VulkanDeviceAllocator( VulkanDevice& device, std::pmr::memory_resource* pResource )
+  : _device( device ), _pResource( pResource ), _blocks( pResource )
+{
+}
+
+void VulkanDeviceAllocator::Initialize( const vk::AllocationCallbacks* allocator )
+{
+    _allocator = allocator;
+    UpdateBudgets();
+}
+
+void VulkanDeviceAllocator::Destroy()
+{
+    const std::scoped_lock lock( _mutex );
+    for ( const auto& upBlock : _blocks )
+    {
+        if ( upBlock->used != 0 )
+        {
+            WindWarn( "Device memory block of type {} still has {} bytes in use.", upBlock->memoryIndex,
+                      upBlock->used );
+        }
+        DestroyBlock( *upBlock );
+    }
+    _blocks.clear();
+}
+
+auto VulkanDeviceAllocator::Allocate( const vk::MemoryRequirements& requirements, const MemoryTypeRequest& request,
+                                      DeviceResourceKind kind ) -> VulkanAllocation
+{
+    if ( _device.physicalDeviceInfo.properties.limits.bufferImageGranularity <= 1 )
+    {
+        kind = DeviceResourceKind::LINEAR;
+    }
+
+    const std::scoped_lock lock( _mutex );
+    const auto memoryIndex = SelectMemoryIndex( requirements, request, kind );
+    const auto blockSize = GetBlockSize( memoryIndex );
+    if ( requirements.size >= std::min( kDedicatedAllocationThreshold, blockSize / 2 ) )
+    {
+        auto& block = CreateBlock( requirements.size, memoryIndex, kind, true );
+        block.used = requirements.size;
+        return { .memory = block.memory,
+                 .offset = 0,
+                 .size = requirements.size,
+                 .memoryIndex = memoryIndex,
+                 .pBlock = &block };
+    }
+
+    const auto allocateFrom = [&]( VulkanMemoryBlock& block ) -> std::optional<VulkanAllocation> {
+        const auto offset = AllocateFromBlock( block, requirements.size, requirements.alignment );
+        if ( !offset.has_value() )
+        {
+            return std::nullopt;
+        }
+        block.used += requirements.size;
+        return VulkanAllocation { .memory = block.memory,
+                                  .offset = *offset,
+                                  .size = requirements.size,
+                                  .memoryIndex = memoryIndex,
+                                  .pBlock = &block };
+    };
+
+    for ( const auto& upBlock : _blocks )
+    {
+        if ( upBlock->isDedicated || upBlock->memoryIndex != memoryIndex || upBlock->kind != kind )
+        {
+            continue;
+        }
+        if ( auto allocation = allocateFrom( *upBlock ) )
+        {
+            return *allocation;
+        }
+    }
+
+    auto allocation = allocateFrom( CreateBlock( blockSize, memoryIndex, kind, false ) );
+    WindAssert( allocation.has_value(), "Failed to allocate from a fresh device memory block." );
+    return *allocation;
+}
+
+void VulkanDeviceAllocator::Free( const VulkanAllocation& allocation )
+{
+    if ( allocation.pBlock == nullptr )
+    {
+        return;
+    }
+
+    const std::scoped_lock lock( _mutex );
+    auto& block = *allocation.pBlock;
+    block.used -= allocation.size;
+    if ( !block.isDedicated )
+    {
+        FreeToBlock( block, allocation.offset, allocation.size );
+    }
+    if ( block.used != 0 )
+    {
+        return;
+    }
+
+    // Keep one empty block per memory type and kind around so a resource churning at the edge of a block does not
+    // allocate and free device memory every time
+    const auto hasSpareBlock = std::ranges::any_of( _blocks, [&block]( const auto& upBlock ) {
+        return upBlock.get() != &block && !upBlock->isDedicated && upBlock->used == 0 &&
+               upBlock->memoryIndex == block.memoryIndex && upBlock->kind == block.kind;
+    } );
+    if ( block.isDedicated || hasSpareBlock )
+    {
+        DestroyBlock( block );
+        std::erase_if( _blocks, [&block]( const auto& upBlock ) { return upBlock.get() == &block; } );
+    }
+}
+
+auto VulkanDeviceAllocator::GetMappedData( const VulkanAllocation& allocation ) const -> void*
+{
+    if ( allocation.pBlock == nullptr || allocation.pBlock->pMapped == nullptr )
+    {
+        return nullptr;
+    }
+    return static_cast<std::byte*>( allocation.pBlock->pMapped ) + allocation.offset;
+}
+
+void VulkanDeviceAllocator::Flush( const VulkanAllocation& allocation, vk::DeviceSize offset,
+                                   vk::DeviceSize size ) const
+{
+    const auto& block = *allocation.pBlock;
+    if ( block.isCoherent || size == 0 )
+    {
+        return;
+    }
+
+    // Flushed ranges have to start and end on nonCoherentAtomSize, blocks are allocated in multiples of it
+    const auto atomSize = _device.physicalDeviceInfo.properties.limits.nonCoherentAtomSize;
+    const auto start = ( allocation.offset + offset ) / atomSize * atomSize;
+    const auto end = std::min( Memory::AlignUp( allocation.offset + offset + size, atomSize ), block.size );
+    _device.device.flushMappedMemoryRanges(
+      vk::MappedMemoryRange { .memory = block.memory, .offset = start, .size = end - start } );
+}
+
+void VulkanDeviceAllocator::UpdateBudgets()
+{
+    const auto& memory = _device.physicalDeviceInfo.memory;
+    const std::scoped_lock lock( _mutex );
+    if ( !_device.physicalDeviceInfo.supportsMemoryBudget )
+    {
+        for ( size_t ind = 0; ind < memory.memoryHeapCount; ++ind )
+        {
+            _heapBudgets[ind].usage = _heapBudgets[ind].allocated;
+            _heapBudgets[ind].budget = memory.memoryHeaps[ind].size * kDefaultHeapBudgetPercent / 100;
+        }
+        return;
+    }
+
+    const auto properties = _device.physicalDevice.getMemoryProperties2<vk::PhysicalDeviceMemoryProperties2,
+                                                                        vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+    const auto& budgetProperties = properties.get<vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+    for ( size_t ind = 0; ind < memory.memoryHeapCount; ++ind )
+    {
+        _heapBudgets[ind].usage = budgetProperties.heapUsage[ind];
+        _heapBudgets[ind].budget = budgetProperties.heapBudget[ind];
+    }
+}
+
+auto VulkanDeviceAllocator::GetHeapBudget( U32 heapIndex ) const -> VulkanHeapBudget
+{
+    const std::scoped_lock lock( _mutex );
+    return _heapBudgets.at( heapIndex );
+}
+
+auto VulkanDeviceAllocator::GetDeviceMemoryCount() const -> size_t
+{
+    const std::scoped_lock lock( _mutex );
+    return _blocks.size();
+}
+
+void VulkanDeviceAllocator::PrintStats() const
+{
+    const std::scoped_lock lock( _mutex );
+    WindDebug( "[[Vulkan Device Memory]]" );
+    WindDebug( "\tDevice Memory Objects: {} - Limit: {}", _blocks.size(),
+               _device.physicalDeviceInfo.properties.limits.maxMemoryAllocationCount );
+    for ( const auto& upBlock : _blocks )
+    {
+        WindDebug( "\tType {} {} Block: {} bytes - Used: {} bytes - Free Ranges: {}", upBlock->memoryIndex,
+                   GetBlockKindName( *upBlock ), upBlock->size, upBlock->used, upBlock->freeRanges.size() );
+    }
+    for ( size_t ind = 0; ind < _device.physicalDeviceInfo.memory.memoryHeapCount; ++ind )
+    {
+        const auto& heapBudget = _heapBudgets[ind];
+        WindDebug( "\tHeap {}: Allocated: {} bytes - Usage: {} bytes - Budget: {} bytes", ind, heapBudget.allocated,
+                   heapBudget.usage, heapBudget.budget );
+    }
+}
+
+auto VulkanDeviceAllocator::CreateBlock( vk::DeviceSize size, U32 memoryIndex, DeviceResourceKind kind,
+                                         bool isDedicated ) -> VulkanMemoryBlock&
+{
+    if ( _blocks.size() >= _device.physicalDeviceInfo.properties.limits.maxMemoryAllocationCount )
+    {
+        WindWarn( "Live device memory objects reached maxMemoryAllocationCount." );
+    }
+
+    const auto memoryFlags = _device.physicalDeviceInfo.memory.memoryTypes[memoryIndex].propertyFlags;
+    const auto isHostVisible = static_cast<bool>( memoryFlags & vk::MemoryPropertyFlagBits::eHostVisible );
+    const auto isCoherent = static_cast<bool>( memoryFlags & vk::MemoryPropertyFlagBits::eHostCoherent );
+    if ( isHostVisible && !isCoherent )
+    {
+        size = Memory::AlignUp( size, _device.physicalDeviceInfo.properties.limits.nonCoherentAtomSize );
+    }
+
+    const auto memoryInfo = vk::MemoryAllocateInfo { .allocationSize = size, .memoryTypeIndex = memoryIndex };
+    auto upBlock = std::make_unique<VulkanMemoryBlock>(
+      VulkanMemoryBlock { .memory = _device.device.allocateMemory( memoryInfo, _allocator ),
+                          .size = size,
+                          .used = 0,
+                          .memoryIndex = memoryIndex,
+                          .kind = kind,
+                          .isDedicated = isDedicated,
+                          .freeRanges = std::pmr::map<vk::DeviceSize, vk::DeviceSize>( _pResource ),
+                          .pMapped = nullptr,
+                          .isCoherent = isCoherent } );
+    if ( isHostVisible )
+    {
+        upBlock->pMapped = _device.device.mapMemory( upBlock->memory, 0, VK_WHOLE_SIZE );
+    }
+    if ( !isDedicated )
+    {
+        upBlock->freeRanges.emplace( 0, size );
+    }
+    WindTrace( "Allocated a {} byte device memory block of type {}.", size, memoryIndex );
+
+    auto& heapBudget = _heapBudgets[_device.physicalDeviceInfo.memory.memoryTypes[memoryIndex].heapIndex];
+    heapBudget.allocated += size;
+    heapBudget.usage += size;
+
+    return *_blocks.emplace_back( std::move( upBlock ) );
+}
+
+void VulkanDeviceAllocator::DestroyBlock( const VulkanMemoryBlock& block )
+{
+    if ( block.pMapped != nullptr )
+    {
+        _device.device.unmapMemory( block.memory );
+    }
+    _device.device.freeMemory( block.memory, _allocator );
+
+    auto& heapBudget = _heapBudgets[_device.physicalDeviceInfo.memory.memoryTypes[block.memoryIndex].heapIndex];
+    heapBudget.allocated -= block.size;
+    heapBudget.usage -= std::min( heapBudget.usage, block.size );
+}
+
+auto VulkanDeviceAllocator::GetBlockSize( U32 memoryIndex ) const -> vk::DeviceSize
+{
+    // Small heaps, such as the host visible part of VRAM, would be eaten by a few full sized blocks
+    const auto& memory = _device.physicalDeviceInfo.memory;
+    const auto heapSize = memory.memoryHeaps[memory.memoryTypes[memoryIndex].heapIndex].size;
+    return std::min( kDeviceMemoryBlockSize, heapSize / 8 );
+}
+
+auto VulkanDeviceAllocator::SelectMemoryIndex( const vk::MemoryRequirements& requirements,
+                                               const MemoryTypeRequest& request, DeviceResourceKind kind ) const -> U32
+{
+    const auto& memory = _device.physicalDeviceInfo.memory;
+    auto memoryTypeBits = requirements.memoryTypeBits;
+    std::optional<U32> bestIndex {};
+    while ( const auto memoryIndex = _device.physicalDeviceInfo.FindMemoryIndex( memoryTypeBits, request ) )
+    {
+        if ( !bestIndex.has_value() )
+        {
+            bestIndex = memoryIndex;
+        }
+        if ( FitsBudget( *memoryIndex, requirements.size, kind ) )
+        {
+            if ( *memoryIndex != *bestIndex )
+            {
+                WindDebug( "Heap {} is over budget, falling back to memory type {}.",
+                           memory.memoryTypes[*bestIndex].heapIndex, *memoryIndex );
+            }
+            return *memoryIndex;
+        }
+
+        // Every type on the heap shares its budget
+        const auto heapIndex = memory.memoryTypes[*memoryIndex].heapIndex;
+        for ( U32 ind = 0; ind < memory.memoryTypeCount; ++ind )
+        {
+            if ( memory.memoryTypes[ind].heapIndex == heapIndex )
+            {
+                memoryTypeBits &= ~( 1U << ind );
+            }
+        }
+    }
+
+    if ( !bestIndex.has_value() )
+    {
+        WindFatal( "Failed to find a suitable memory index." );
+    }
+    WindWarn( "Every suitable heap is over budget, heap {} may start paging.",
+              memory.memoryTypes[*bestIndex].heapIndex );
+    return *bestIndex;
+}
+
+auto VulkanDeviceAllocator::FitsBudget( U32 memoryIndex, vk::DeviceSize size, DeviceResourceKind kind ) const -> bool
+{
+    // Sub-allocating from an existing block does not grow the heap usage
+    const auto hasRoom = std::ranges::any_of( _blocks, [=]( const auto& upBlock ) {
+        return !upBlock->isDedicated && upBlock->memoryIndex == memoryIndex && upBlock->kind == kind &&
+               upBlock->size - upBlock->used >= size;
+    } );
+    if ( hasRoom )
+    {
+        return true;
+    }
+
+    const auto blockSize = GetBlockSize( memoryIndex );
+    const auto newMemory = size >= std::min( kDedicatedAllocationThreshold, blockSize / 2 ) ? size : blockSize;
+    const auto& heapBudget = _heapBudgets[_device.physicalDeviceInfo.memory.memoryTypes[memoryIndex].heapIndex];
+    return heapBudget.usage + newMemory <= heapBudget.budget;
+}
+
+auto VulkanDeviceAllocator::AllocateFromBlock( VulkanMemoryBlock& block, vk::DeviceSize size,
+                                               vk::DeviceSize alignment ) -> std::optional<vk::DeviceSize>
+{
+    for ( auto it = block.freeRanges.begin(); it != block.freeRanges.end(); ++it )
+    {
+        const auto [rangeOffset, rangeSize] = *it;
+        const auto offset = Memory::AlignUp( rangeOffset, alignment );
+        const auto end = offset + size;
+        const auto rangeEnd = rangeOffset + rangeSize;
+        if ( end > rangeEnd )
+        {
+            continue;
+        }
+
+        // The alignment padding in front stays free
+        block.freeRanges.erase( it );
+        if ( offset > rangeOffset )
+        {
+            block.freeRanges.emplace( rangeOffset, offset - rangeOffset );
+        }
+        if ( end < rangeEnd )
+        {
+            block.freeRanges.emplace( end, rangeEnd - end );
+        }
+        return offset;
+    }
+    return std::nullopt;
+}
+
+void VulkanDeviceAllocator::FreeToBlock( VulkanMemoryBlock& block, vk::DeviceSize offset, vk::DeviceSize size )
+{
+    auto next = block.freeRanges.lower_bound( offset );
+    if ( next != block.freeRanges.end() && offset + size == next->first )
+    {
+        size += next->second;
+        next = block.freeRanges.erase( next );
+    }
+    if ( next != block.freeRanges.begin() )
+    {
+        auto prev = std::prev( next );
+        if ( prev->first + prev->second == offset )
+        {
+            prev->second += size;
+            return;
+        }
+    }
+    block.freeRanges.emplace_hint( next, offset, size );
+}
+
+}  // namespace WindEngine::Core::Render
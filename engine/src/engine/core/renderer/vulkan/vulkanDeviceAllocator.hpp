@@ -0,0 +1,128 @@
+#ifndef WINDENGINE_VULKANDEVICEALLOCATOR_HPP
+#define WINDENGINE_VULKANDEVICEALLOCATOR_HPP
+
+#include "defines.hpp"
+#include <array>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <vulkan/vulkan.hpp>
+
+namespace WindEngine::Core::Render
+{
+
+struct VulkanDevice;
+
+constexpr vk::DeviceSize kDeviceMemoryBlockSize = 64 * 1024 * 1024;
+// Resources at least this large get their own vk::DeviceMemory instead of a range in a shared block
+constexpr vk::DeviceSize kDedicatedAllocationThreshold = kDeviceMemoryBlockSize / 2;
+
+// Share of a heap the allocator plans with when the driver does not report a budget
+constexpr vk::DeviceSize kDefaultHeapBudgetPercent = 80;
+
+// Memory types are scored against these flags. A type has to have every required flag, each preferred flag it has
+// counts for it and each avoided flag outweighs all preferred ones.
+struct MemoryTypeRequest
+{
+    vk::MemoryPropertyFlags required {};
+    vk::MemoryPropertyFlags preferred {};
+    vk::MemoryPropertyFlags avoided {};
+};
+
+struct VulkanHeapBudget
+{
+    // Bytes used by the whole process, as last reported by VK_EXT_memory_budget plus the blocks made since
+    vk::DeviceSize usage {};
+    // Bytes the process can use before the driver starts paging
+    vk::DeviceSize budget {};
+    // Bytes in blocks owned by this allocator
+    vk::DeviceSize allocated {};
+};
+
+// Buffers and linear images can share a page with each other, optimal images only with other optimal images. Blocks
+// hold a single kind when bufferImageGranularity is larger than one, so neighbours never alias a granularity page.
+enum class DeviceResourceKind
+{
+    LINEAR,
+    OPTIMAL
+};
+
+struct VulkanMemoryBlock;
+
+struct VulkanAllocation
+{
+    vk::DeviceMemory memory {};
+    vk::DeviceSize offset {};
+    vk::DeviceSize size {};
+    U32 memoryIndex { UINT32_MAX };
+    VulkanMemoryBlock* pBlock { nullptr };
+};
+
+struct VulkanMemoryBlock
+{
+    vk::DeviceMemory memory {};
+    vk::DeviceSize size {};
+    vk::DeviceSize used {};
+    U32 memoryIndex {};
+    DeviceResourceKind kind {};
+    bool isDedicated {};
+    // Offset to size of each free range, neighbouring ranges are merged on free
+    std::pmr::map<vk::DeviceSize, vk::DeviceSize> freeRanges;
+    // Host visible blocks stay mapped for their whole lifetime
+    void* pMapped { nullptr };
+    bool isCoherent {};
+};
+
+// Sub-allocates device memory for buffers and images out of large per memory type blocks, which keeps the number of
+// live vk::DeviceMemory objects far below maxMemoryAllocationCount. Thread safe.
+struct VulkanDeviceAllocator
+{
+    VulkanDeviceAllocator( VulkanDevice& device, std::pmr::memory_resource* pResource );
+
+    void Initialize( const vk::AllocationCallbacks* allocator );
+    void Destroy();
+
+    // Picks the best scoring memory type whose heap still has budget left, falling back to the next heap before the
+    // driver has to page
+    [[nodiscard]] auto Allocate( const vk::MemoryRequirements& requirements, const MemoryTypeRequest& request,
+                                 DeviceResourceKind kind ) -> VulkanAllocation;
+    void Free( const VulkanAllocation& allocation );
+
+    // Pointer to the allocation inside its persistently mapped block, nullptr if the memory is not host visible
+    [[nodiscard]] auto GetMappedData( const VulkanAllocation& allocation ) const -> void*;
+    // Makes host writes to a range of the allocation visible to the device, only does work for non-coherent memory
+    void Flush( const VulkanAllocation& allocation, vk::DeviceSize offset, vk::DeviceSize size ) const;
+
+    // Refreshes the heap budgets, called once per frame since the budget changes with other processes
+    void UpdateBudgets();
+    [[nodiscard]] auto GetHeapBudget( U32 heapIndex ) const -> VulkanHeapBudget;
+
+    [[nodiscard]] auto GetDeviceMemoryCount() const -> size_t;
+    void PrintStats() const;
+
+private:
+    [[nodiscard]] auto CreateBlock( vk::DeviceSize size, U32 memoryIndex, DeviceResourceKind kind, bool isDedicated )
+      -> VulkanMemoryBlock&;
+    void DestroyBlock( const VulkanMemoryBlock& block );
+    [[nodiscard]] auto GetBlockSize( U32 memoryIndex ) const -> vk::DeviceSize;
+    [[nodiscard]] auto SelectMemoryIndex( const vk::MemoryRequirements& requirements, const MemoryTypeRequest& request,
+                                          DeviceResourceKind kind ) const -> U32;
+    [[nodiscard]] auto FitsBudget( U32 memoryIndex, vk::DeviceSize size, DeviceResourceKind kind ) const -> bool;
+
+    [[nodiscard]] static auto AllocateFromBlock( VulkanMemoryBlock& block, vk::DeviceSize size,
+                                                 vk::DeviceSize alignment ) -> std::optional<vk::DeviceSize>;
+    static void FreeToBlock( VulkanMemoryBlock& block, vk::DeviceSize offset, vk::DeviceSize size );
+
+    VulkanDevice& _device;
+    const vk::AllocationCallbacks* _allocator { nullptr };
+    std::pmr::memory_resource* _pResource;
+    std::pmr::vector<std::unique_ptr<VulkanMemoryBlock>> _blocks;
+    std::array<VulkanHeapBudget, VK_MAX_MEMORY_HEAPS> _heapBudgets {};
+    mutable std::mutex _mutex;
+};
+
+}  // namespace WindEngine::Core::Render
+
+#endif  // WINDENGINE_VULKANDEVICEALLOCATOR_HPP
@@ -0,0 +1,64 @@
+#include "vulkanFrameResources.hpp"
+#include <ranges>
+
+namespace WindEngine::Core::Render
+{
+
+VulkanDeletionQueue::VulkanDeletionQueue( std::pmr::memory_resource* pResource ) : _deleters( pResource )
+{
+}
+
+void VulkanDeletionQueue::Push( std::function<void()> deleter )
+{
+    _deleters.push_back( std::move( deleter ) );
+}
+
+void VulkanDeletionQueue::Flush()
+{
+    for ( auto& deleter : std::ranges::reverse_view( _deleters ) )
+    {
+        deleter();
+    }
+    _deleters.clear();
+}
+
+FrameResources::FrameResources( std::pmr::memory_resource* pResource ) : deletionQueue( pResource )
+{
+}
+
+void FrameResources::Initialize( const vk::Device& device, U32 queueFamilyIndex,
+                                 const vk::AllocationCallbacks* allocator )
+{
+    const auto fenceInfo = vk::FenceCreateInfo {
+        .flags = vk::FenceCreateFlagBits::eSignaled,
+    };
+    renderSemaphore = device.createSemaphore( {}, allocator );
+    presentSemaphore = device.createSemaphore( {}, allocator );
+    fence = device.createFence( fenceInfo, allocator );
+
+    // The buffer is recorded once per use and reset with its pool, so it needs no individual reset
+    const auto poolInfo = vk::CommandPoolCreateInfo {
+        .flags = vk::CommandPoolCreateFlagBits::eTransient,
+        .queueFamilyIndex = queueFamilyIndex,
+    };
+    commandPool = device.createCommandPool( poolInfo, allocator );
+    commandBuffer.Allocate( device, commandPool, true );
+}
+
+void FrameResources::Destroy( const vk::Device& device, const vk::AllocationCallbacks* allocator )
+{
+    deletionQueue.Flush();
+    // Destroying the pool frees the buffer
+    device.destroy( commandPool, allocator );
+    device.destroy( renderSemaphore, allocator );
+    device.destroy( presentSemaphore, allocator );
+    device.destroy( fence, allocator );
+}
+
+void FrameResources::Reset( const vk::Device& device )
+{
+    deletionQueue.Flush();
+    device.resetCommandPool( commandPool );
+}
+
+}  // namespace WindEngine::Core::Render
@@ -0,0 +1,54 @@
+#ifndef WINDENGINE_VULKANFRAMERESOURCES_HPP
+#define WINDENGINE_VULKANFRAMERESOURCES_HPP
+
+#include "defines.hpp"
+#include "vulkanCommandBuffer.hpp"
+#include <functional>
+#include <memory_resource>
+#include <vulkan/vulkan.hpp>
+
+namespace WindEngine::Core::Render
+{
+
+// Destruction deferred until the frame that may still use the objects has completed on the GPU
+struct VulkanDeletionQueue
+{
+    explicit VulkanDeletionQueue( std::pmr::memory_resource* pResource );
+
+    void Push( std::function<void()> deleter );
+    // Newest first, so objects go before whatever they were created from
+    void Flush();
+
+    [[nodiscard]] auto GetSize() const -> size_t
+    {
+        return _deleters.size();
+    }
+
+private:
+    std::pmr::vector<std::function<void()>> _deleters;
+};
+
+// Everything one frame in flight records into or hands to the GPU. The whole bundle is reused once the fence of the
+// frame has signaled, the command pool is reset in one call rather than buffer by buffer.
+struct FrameResources
+{
+    vk::Semaphore renderSemaphore;
+    vk::Semaphore presentSemaphore;
+    vk::Fence fence;
+    vk::CommandPool commandPool;
+    VulkanCommandBuffer commandBuffer {};
+    VulkanDeletionQueue deletionQueue;
+
+    explicit FrameResources( std::pmr::memory_resource* pResource );
+
+    void Initialize( const vk::Device& device, U32 queueFamilyIndex, const vk::AllocationCallbacks* allocator );
+    // Flushes the deletion queue, the GPU has to be idle
+    void Destroy( const vk::Device& device, const vk::AllocationCallbacks* allocator );
+
+    // Called once the fence was waited on
+    void Reset( const vk::Device& device );
+};
+
+}  // namespace WindEngine::Core::Render
+
+#endif  // WINDENGINE_VULKANFRAMERESOURCES_HPP
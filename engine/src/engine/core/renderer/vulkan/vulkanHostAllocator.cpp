@@ -0,0 +1,206 @@
+#include "vulkanHostAllocator.hpp"
+#include "logger.hpp"
+#include "memoryUtils.hpp"
+#include "sizeClassAllocator.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace WindEngine::Core::Render
+{
+using namespace WindEngine::Core::Memory;
+
+constexpr std::array<const char*, kSystemAllocationScopeCount> kScopeNames { "COMMAND", "OBJECT", "CACHE", "DEVICE",
+                                                                             "INSTANCE" };
+
+struct VulkanHostAllocator::AllocationHeader
+{
+    void* pBase;
+    size_t size;
+    size_t sourceSize;
+    VkSystemAllocationScope scope;
+    bool isCommandScoped;
+};
+
+// Command scope allocations are freed before the Vulkan call that made them returns, so they never leave the thread
+static auto GetCommandScopeAllocator() -> SizeClassAllocator&
+{
+    thread_local SizeClassAllocator allocator;
+    return allocator;
+}
+
+VulkanHostAllocator::VulkanHostAllocator( AllocationManager& allocationManager )
+  : _allocationManager( allocationManager )
+{
+    static_cast<VkAllocationCallbacks&>( _callbacks ) =
+      VkAllocationCallbacks { .pUserData = this,
+                              .pfnAllocation = &AllocationCallback,
+                              .pfnReallocation = &ReallocationCallback,
+                              .pfnFree = &FreeCallback,
+                              .pfnInternalAllocation = &InternalAllocationCallback,
+                              .pfnInternalFree = &InternalFreeCallback };
+}
+
+auto VulkanHostAllocator::GetCallbacks() -> vk::AllocationCallbacks*
+{
+    return &_callbacks;
+}
+
+auto VulkanHostAllocator::GetScopeStats( VkSystemAllocationScope scope ) const -> VulkanHostScopeStats
+{
+    const auto& counters = _scopes.at( static_cast<size_t>( scope ) );
+    return { .allocatedBytes = counters.allocatedBytes.load( std::memory_order_relaxed ),
+             .peakBytes = counters.peakBytes.load( std::memory_order_relaxed ),
+             .liveAllocations = counters.liveAllocations.load( std::memory_order_relaxed ) };
+}
+
+auto VulkanHostAllocator::GetInternalAllocated() const -> U64
+{
+    return _internalAllocated.load( std::memory_order_relaxed );
+}
+
+void VulkanHostAllocator::PrintStats() const
+{
+    WindDebug( "[[Vulkan Host Memory]]" );
+    for ( size_t ind = 0; ind != _scopes.size(); ++ind )
+    {
+        const auto stats = GetScopeStats( static_cast<VkSystemAllocationScope>( ind ) );
+        WindDebug( "\t{} Allocations: {} bytes - Peak: {} bytes - Live: {}", kScopeNames[ind], stats.allocatedBytes,
+                   stats.peakBytes, stats.liveAllocations );
+    }
+    WindDebug( "\tInternal Allocations: {} bytes", GetInternalAllocated() );
+}
+
+auto VKAPI_PTR VulkanHostAllocator::AllocationCallback( void* pUserData, size_t size, size_t alignment,
+                                                        VkSystemAllocationScope scope ) -> void*
+{
+    return static_cast<VulkanHostAllocator*>( pUserData )->Allocate( size, alignment, scope );
+}
+
+auto VKAPI_PTR VulkanHostAllocator::ReallocationCallback( void* pUserData, void* pOriginal, size_t size,
+                                                          size_t alignment, VkSystemAllocationScope scope ) -> void*
+{
+    return static_cast<VulkanHostAllocator*>( pUserData )->Reallocate( pOriginal, size, alignment, scope );
+}
+
+void VKAPI_PTR VulkanHostAllocator::FreeCallback( void* pUserData, void* pMemory )
+{
+    static_cast<VulkanHostAllocator*>( pUserData )->Free( pMemory );
+}
+
+void VKAPI_PTR VulkanHostAllocator::InternalAllocationCallback(
+  void* pUserData, size_t size, [[maybe_unused]] VkInternalAllocationType allocationType,
+  [[maybe_unused]] VkSystemAllocationScope scope )
+{
+    static_cast<VulkanHostAllocator*>( pUserData )->_internalAllocated.fetch_add( size, std::memory_order_relaxed );
+}
+
+void VKAPI_PTR VulkanHostAllocator::InternalFreeCallback( void* pUserData, size_t size,
+                                                          [[maybe_unused]] VkInternalAllocationType allocationType,
+                                                          [[maybe_unused]] VkSystemAllocationScope scope )
+{
+    static_cast<VulkanHostAllocator*>( pUserData )->_internalAllocated.fetch_sub( size, std::memory_order_relaxed );
+}
+
+auto VulkanHostAllocator::Allocate( size_t size, size_t alignment, VkSystemAllocationScope scope ) -> void*
+{
+    if ( size == 0 )
+    {
+        return nullptr;
+    }
+
+    // The header sits in front of the payload, padded so the payload keeps the requested alignment
+    const auto payloadAlignment = std::max( alignment, kDefaultAlignment );
+    const auto headerSize = AlignUp( sizeof( AllocationHeader ), payloadAlignment );
+    const auto sourceSize = headerSize + size;
+
+    void* pBase = nullptr;
+    auto isCommandScoped = false;
+    if ( scope == VK_SYSTEM_ALLOCATION_SCOPE_COMMAND )
+    {
+        pBase = GetCommandScopeAllocator().Allocate( sourceSize, payloadAlignment );
+        isCommandScoped = pBase != nullptr;
+    }
+    if ( pBase == nullptr )
+    {
+        pBase = _allocationManager.Allocate( sourceSize, AllocationType::RENDERER, payloadAlignment );
+    }
+    if ( pBase == nullptr )
+    {
+        WindError( "Failed to allocate {} bytes of Vulkan host memory.", size );
+        return nullptr;
+    }
+
+    auto* pPayload = static_cast<std::byte*>( pBase ) + headerSize;
+    auto* pHeader = reinterpret_cast<AllocationHeader*>( pPayload ) - 1;
+    *pHeader = AllocationHeader { .pBase = pBase,
+                                  .size = size,
+                                  .sourceSize = sourceSize,
+                                  .scope = scope,
+                                  .isCommandScoped = isCommandScoped };
+
+    _scopes.at( static_cast<size_t>( scope ) ).OnAllocate( size );
+    return pPayload;
+}
+
+auto VulkanHostAllocator::Reallocate( void* pOriginal, size_t size, size_t alignment, VkSystemAllocationScope scope )
+  -> void*
+{
+    if ( pOriginal == nullptr )
+    {
+        return Allocate( size, alignment, scope );
+    }
+    if ( size == 0 )
+    {
+        Free( pOriginal );
+        return nullptr;
+    }
+
+    // On failure the original allocation has to stay untouched
+    auto* pMemory = Allocate( size, alignment, scope );
+    if ( pMemory != nullptr )
+    {
+        const auto* pHeader = static_cast<AllocationHeader*>( pOriginal ) - 1;
+        std::memcpy( pMemory, pOriginal, std::min( size, pHeader->size ) );
+        Free( pOriginal );
+    }
+    return pMemory;
+}
+
+void VulkanHostAllocator::Free( void* pMemory )
+{
+    if ( pMemory == nullptr )
+    {
+        return;
+    }
+
+    const auto header = *( static_cast<AllocationHeader*>( pMemory ) - 1 );
+    _scopes.at( static_cast<size_t>( header.scope ) ).OnFree( header.size );
+
+    if ( header.isCommandScoped )
+    {
+        GetCommandScopeAllocator().Free( header.pBase );
+    }
+    else
+    {
+        _allocationManager.Free( header.pBase, header.sourceSize, AllocationType::RENDERER );
+    }
+}
+
+void VulkanHostAllocator::ScopeCounters::OnAllocate( size_t size )
+{
+    const auto current = allocatedBytes.fetch_add( size, std::memory_order_relaxed ) + size;
+    liveAllocations.fetch_add( 1, std::memory_order_relaxed );
+
+    auto peak = peakBytes.load( std::memory_order_relaxed );
+    while ( current > peak && !peakBytes.compare_exchange_weak( peak, current, std::memory_order_relaxed ) )
+    {
+    }
+}
+
+void VulkanHostAllocator::ScopeCounters::OnFree( size_t size )
+{
+    allocatedBytes.fetch_sub( size, std::memory_order_relaxed );
+    liveAllocations.fetch_sub( 1, std::memory_order_relaxed );
+}
+
+}  // namespace WindEngine::Core::Render
@@ -0,0 +1,72 @@
+#ifndef WINDENGINE_VULKANHOSTALLOCATOR_HPP
+#define WINDENGINE_VULKANHOSTALLOCATOR_HPP
+
+#include "allocationManager.hpp"
+#include "defines.hpp"
+#include <array>
+#include <atomic>
+#include <vulkan/vulkan.hpp>
+
+namespace WindEngine::Core::Render
+{
+
+constexpr size_t kSystemAllocationScopeCount = VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE + 1;
+
+struct VulkanHostScopeStats
+{
+    U64 allocatedBytes;
+    U64 peakBytes;
+    U64 liveAllocations;
+};
+
+// Host allocation callbacks handed to the driver. Allocations are tagged as RENDERER in the AllocationManager,
+// except small command scope allocations, which live only for the duration of a Vulkan call and are served from
+// a per-thread pool.
+class VulkanHostAllocator
+{
+public:
+    explicit VulkanHostAllocator( Memory::AllocationManager& allocationManager );
+
+    [[nodiscard]] auto GetCallbacks() -> vk::AllocationCallbacks*;
+    [[nodiscard]] auto GetScopeStats( VkSystemAllocationScope scope ) const -> VulkanHostScopeStats;
+    [[nodiscard]] auto GetInternalAllocated() const -> U64;
+
+    void PrintStats() const;
+
+private:
+    struct AllocationHeader;
+
+    struct ScopeCounters
+    {
+        std::atomic<U64> allocatedBytes { 0 };
+        std::atomic<U64> peakBytes { 0 };
+        std::atomic<U64> liveAllocations { 0 };
+
+        void OnAllocate( size_t size );
+        void OnFree( size_t size );
+    };
+
+    static auto VKAPI_PTR AllocationCallback( void* pUserData, size_t size, size_t alignment,
+                                              VkSystemAllocationScope scope ) -> void*;
+    static auto VKAPI_PTR ReallocationCallback( void* pUserData, void* pOriginal, size_t size, size_t alignment,
+                                                VkSystemAllocationScope scope ) -> void*;
+    static void VKAPI_PTR FreeCallback( void* pUserData, void* pMemory );
+    static void VKAPI_PTR InternalAllocationCallback( void* pUserData, size_t size,
+                                                      VkInternalAllocationType allocationType,
+                                                      VkSystemAllocationScope scope );
+    static void VKAPI_PTR InternalFreeCallback( void* pUserData, size_t size, VkInternalAllocationType allocationType,
+                                                VkSystemAllocationScope scope );
+
+    auto Allocate( size_t size, size_t alignment, VkSystemAllocationScope scope ) -> void*;
+    auto Reallocate( void* pOriginal, size_t size, size_t alignment, VkSystemAllocationScope scope ) -> void*;
+    void Free( void* pMemory );
+
+    Memory::AllocationManager& _allocationManager;
+    vk::AllocationCallbacks _callbacks {};
+    std::array<ScopeCounters, kSystemAllocationScopeCount> _scopes {};
+    std::atomic<U64> _internalAllocated { 0 };
+};
+
+}  // namespace WindEngine::Core::Render
+
+#endif  // WINDENGINE_VULKANHOSTALLOCATOR_HPP
@@ -1,5 +1,9 @@
 #include "vulkanImage.hpp"
+#include "logger.hpp"
 #include "vulkanDevice.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
 
 namespace WindEngine::Core::Render
 {
@@ -11,15 +15,46 @@ VulkanImage::VulkanImage( VulkanDevice& device, vk::AllocationCallbacks* allocat
 
 void VulkanImage::Initialize( const VulkanImageCreateInfo& createInfo )
 {
+    extent = createInfo.extent;
+    format = createInfo.format;
+    aspectFlags = createInfo.aspectFlags;
+    mipLevels = createInfo.mipLevels;
+
+    auto usage = createInfo.usage;
+    if ( createInfo.hasMipChain )
+    {
+        const auto formatProperties = _device->physicalDevice.getFormatProperties( format );
+        const auto features = createInfo.tiling == vk::ImageTiling::eLinear ? formatProperties.linearTilingFeatures
+                                                                            : formatProperties.optimalTilingFeatures;
+        constexpr auto kBlitFeatures = vk::FormatFeatureFlagBits::eBlitSrc | vk::FormatFeatureFlagBits::eBlitDst;
+        if ( ( features & kBlitFeatures ) == kBlitFeatures )
+        {
+            mipLevels = GetMipLevelCount( extent );
+            usage |= vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst;
+        }
+        else
+        {
+            WindWarn( "{} can not be blitted, the image gets a single mip level.", vk::to_string( format ) );
+        }
+
+        mipFilter = vk::Filter::eLinear;
+        if ( !( features & vk::FormatFeatureFlagBits::eSampledImageFilterLinear ) )
+        {
+            WindDebug( "{} does not support linear filtering, mips are generated with nearest filtering.",
+                       vk::to_string( format ) );
+            mipFilter = vk::Filter::eNearest;
+        }
+    }
+
     const auto imageInfo = vk::ImageCreateInfo {
         .imageType = createInfo.imageType,
         .format = createInfo.format,
         .extent = createInfo.extent,
-        .mipLevels = 5,
+        .mipLevels = mipLevels,
         .arrayLayers = 1,
         .samples = vk::SampleCountFlagBits::e1,
         .tiling = createInfo.tiling,
-        .usage = createInfo.usage,
+        .usage = usage,
         .sharingMode = vk::SharingMode::eExclusive,
         .queueFamilyIndexCount = 0,
         .pQueueFamilyIndices = nullptr,
@@ -28,13 +63,14 @@ void VulkanImage::Initialize( const VulkanImageCreateInfo& createInfo )
     image = _device->device.createImage( imageInfo, _allocator );
 
     const auto memoryRequirements = _device->device.getImageMemoryRequirements( image );
-    const auto memoryIndex =
-      _device->physicalDeviceInfo.FindMemoryIndex( memoryRequirements.memoryTypeBits, createInfo.memoryFlags );
-    const auto allocateInfo =
-      vk::MemoryAllocateInfo { .allocationSize = memoryRequirements.size, .memoryTypeIndex = memoryIndex };
-    deviceMemory = _device->device.allocateMemory( allocateInfo, _allocator );
+    const auto resourceKind =
+      createInfo.tiling == vk::ImageTiling::eLinear ? DeviceResourceKind::LINEAR : DeviceResourceKind::OPTIMAL;
+    const auto memoryRequest = MemoryTypeRequest { .required = createInfo.memoryFlags,
+                                                   .preferred = createInfo.preferredMemoryFlags,
+                                                   .avoided = createInfo.avoidedMemoryFlags };
+    allocation = _device->memoryAllocator.Allocate( memoryRequirements, memoryRequest, resourceKind );
 
-    _device->device.bindImageMemory( image, deviceMemory, 0 );
+    _device->device.bindImageMemory( image, allocation.memory, allocation.offset );
 
     const auto imageViewInfo =
       vk::ImageViewCreateInfo { .image = image,
@@ -43,7 +79,7 @@ void VulkanImage::Initialize( const VulkanImageCreateInfo& createInfo )
                                 .components = {},
                                 .subresourceRange = vk::ImageSubresourceRange { .aspectMask = createInfo.aspectFlags,
                                                                                 .baseMipLevel = 0,
-                                                                                .levelCount = 1,
+                                                                                .levelCount = mipLevels,
                                                                                 .baseArrayLayer = 0,
                                                                                 .layerCount = 1 } };
     imageView = _device->device.createImageView( imageViewInfo, _allocator );
@@ -52,8 +88,76 @@ void VulkanImage::Initialize( const VulkanImageCreateInfo& createInfo )
 void VulkanImage::Destroy()
 {
     _device->device.destroy( imageView, _allocator );
-    _device->device.freeMemory( deviceMemory, _allocator );
     _device->device.destroy( image, _allocator );
+    _device->memoryAllocator.Free( allocation );
+    allocation = {};
+}
+
+void VulkanImage::RecordMipGeneration( const vk::CommandBuffer& commandBuffer, vk::PipelineStageFlags dstStage ) const
+{
+    auto barrier = vk::ImageMemoryBarrier { .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+                                            .dstAccessMask = vk::AccessFlagBits::eTransferRead,
+                                            .oldLayout = vk::ImageLayout::eTransferDstOptimal,
+                                            .newLayout = vk::ImageLayout::eTransferSrcOptimal,
+                                            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                                            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                                            .image = image,
+                                            .subresourceRange = { .aspectMask = aspectFlags,
+                                                                  .baseMipLevel = 0,
+                                                                  .levelCount = 1,
+                                                                  .baseArrayLayer = 0,
+                                                                  .layerCount = 1 } };
+
+    auto srcExtent = vk::Offset3D { static_cast<I32>( extent.width ), static_cast<I32>( extent.height ),
+                                    static_cast<I32>( extent.depth ) };
+    for ( U32 level = 1; level < mipLevels; ++level )
+    {
+        const auto dstExtent = vk::Offset3D {
+            std::max( srcExtent.x / 2, 1 ), std::max( srcExtent.y / 2, 1 ), std::max( srcExtent.z / 2, 1 ) };
+
+        // The source level is done being written, either by the upload or by the previous blit
+        barrier.subresourceRange.baseMipLevel = level - 1;
+        barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+        barrier.dstAccessMask = vk::AccessFlagBits::eTransferRead;
+        barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+        barrier.newLayout = vk::ImageLayout::eTransferSrcOptimal;
+        commandBuffer.pipelineBarrier( vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer, {},
+                                       {}, {}, barrier );
+
+        const auto blit = vk::ImageBlit { .srcSubresource = { .aspectMask = aspectFlags,
+                                                              .mipLevel = level - 1,
+                                                              .baseArrayLayer = 0,
+                                                              .layerCount = 1 },
+                                          .srcOffsets = std::array { vk::Offset3D { 0, 0, 0 }, srcExtent },
+                                          .dstSubresource = { .aspectMask = aspectFlags,
+                                                              .mipLevel = level,
+                                                              .baseArrayLayer = 0,
+                                                              .layerCount = 1 },
+                                          .dstOffsets = std::array { vk::Offset3D { 0, 0, 0 }, dstExtent } };
+        commandBuffer.blitImage( image, vk::ImageLayout::eTransferSrcOptimal, image,
+                                 vk::ImageLayout::eTransferDstOptimal, blit, mipFilter );
+
+        barrier.srcAccessMask = vk::AccessFlagBits::eTransferRead;
+        barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+        barrier.oldLayout = vk::ImageLayout::eTransferSrcOptimal;
+        barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+        commandBuffer.pipelineBarrier( vk::PipelineStageFlagBits::eTransfer, dstStage, {}, {}, {}, barrier );
+
+        srcExtent = dstExtent;
+    }
+
+    // The last level is only ever written
+    barrier.subresourceRange.baseMipLevel = mipLevels - 1;
+    barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+    barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+    barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+    barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+    commandBuffer.pipelineBarrier( vk::PipelineStageFlagBits::eTransfer, dstStage, {}, {}, {}, barrier );
+}
+
+auto VulkanImage::GetMipLevelCount( const vk::Extent3D& extent ) -> U32
+{
+    return std::bit_width( std::max( { extent.width, extent.height, extent.depth } ) );
 }
 
 }  // namespace WindEngine::Core::Render
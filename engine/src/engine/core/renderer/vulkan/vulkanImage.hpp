@@ -17,8 +17,14 @@ struct VulkanImageCreateInfo
     vk::Format format {};
     vk::ImageType imageType {};
     vk::MemoryPropertyFlags memoryFlags {};
+    vk::MemoryPropertyFlags preferredMemoryFlags {};
+    vk::MemoryPropertyFlags avoidedMemoryFlags {};
     vk::ImageTiling tiling {};
     vk::ImageUsageFlags usage;
+    // Allocates every level down to 1x1, filled by RecordMipGeneration
+    bool hasMipChain {};
+    // Level count of images without a generated chain, whose levels are uploaded one by one
+    U32 mipLevels { 1 };
 };
 
 struct VulkanImage : public VulkanHandle
@@ -26,10 +32,22 @@ struct VulkanImage : public VulkanHandle
     VulkanImage( VulkanDevice& device, vk::AllocationCallbacks* allocator );
     vk::Image image {};
     vk::ImageView imageView {};
-    vk::DeviceMemory deviceMemory {};
+    VulkanAllocation allocation {};
+    vk::Extent3D extent {};
+    vk::Format format {};
+    vk::ImageAspectFlags aspectFlags {};
+    U32 mipLevels { 1 };
+    // Linear unless the format can not be filtered linearly
+    vk::Filter mipFilter { vk::Filter::eLinear };
 
     void Initialize( const VulkanImageCreateInfo& createInfo );
     void Destroy() override;
+
+    // Blits every level from the one above it. Expects all levels in eTransferDstOptimal with level 0 written and
+    // leaves them in eShaderReadOnlyOptimal. Needs a graphics queue.
+    void RecordMipGeneration( const vk::CommandBuffer& commandBuffer, vk::PipelineStageFlags dstStage ) const;
+
+    [[nodiscard]] static auto GetMipLevelCount( const vk::Extent3D& extent ) -> U32;
 };
 
 }  // namespace WindEngine::Core::Render
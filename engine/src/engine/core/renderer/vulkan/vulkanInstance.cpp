@@ -126,7 +126,7 @@ void VulkanInstance::Initialize( const char* applicationName, SDL_Window* window
 void VulkanInstance::Destroy( vk::AllocationCallbacks* allocator ) const
 {
 #if defined( _DBG )
-    instance.destroyDebugUtilsMessengerEXT( debugMessenger );
+    instance.destroyDebugUtilsMessengerEXT( debugMessenger, allocator );
 #endif
     instance.destroy( allocator );
 }
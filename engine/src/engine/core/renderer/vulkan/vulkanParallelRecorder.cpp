@@ -0,0 +1,147 @@
+#include "vulkanParallelRecorder.hpp"
+#include "assert.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <exception>
+#include <latch>
+
+namespace WindEngine::Core::Render
+{
+
+VulkanParallelRecorder::VulkanParallelRecorder( VulkanDevice& device, vk::AllocationCallbacks* allocator,
+                                                ThreadPool& threadPool, std::pmr::memory_resource* pResource )
+  : VulkanHandle( &device, allocator ), _threadPool( threadPool ), _pResource( pResource ), _pools( pResource )
+{
+}
+
+void VulkanParallelRecorder::Initialize( U32 framesInFlight )
+{
+    _poolsPerFrame = _threadPool.GetThreadCount() + 1;
+    // Buffers are recorded once per frame and the whole pool is reset, so they never need resetting one by one
+    const auto poolInfo = vk::CommandPoolCreateInfo {
+        .flags = vk::CommandPoolCreateFlagBits::eTransient,
+        .queueFamilyIndex = _device->indices.graphics,
+    };
+    _pools.reserve( static_cast<size_t>( framesInFlight ) * _poolsPerFrame );
+    for ( U32 ind = 0; ind < framesInFlight * _poolsPerFrame; ++ind )
+    {
+        _pools.push_back( { .pool = _device->device.createCommandPool( poolInfo, _allocator ),
+                            .buffers = std::pmr::vector<VulkanCommandBuffer>( _pResource ) } );
+    }
+    WindInfo( "Created {} command pools for parallel recording.", _pools.size() );
+}
+
+void VulkanParallelRecorder::Destroy()
+{
+    // Destroying a pool frees its buffers
+    for ( const auto& threadPool : _pools )
+    {
+        _device->device.destroy( threadPool.pool, _allocator );
+    }
+    _pools.clear();
+}
+
+void VulkanParallelRecorder::BeginFrame( U32 frameIndex )
+{
+    _frameIndex = frameIndex;
+    for ( U32 ind = 0; ind < _poolsPerFrame; ++ind )
+    {
+        auto& threadPool = _pools.at( static_cast<size_t>( frameIndex ) * _poolsPerFrame + ind );
+        _device->device.resetCommandPool( threadPool.pool );
+        threadPool.usedCount = 0;
+    }
+}
+
+void VulkanParallelRecorder::Record( const vk::CommandBuffer& primaryBuffer,
+                                     const vk::CommandBufferInheritanceInfo& inheritanceInfo, U32 itemCount,
+                                     const RecordFunction& record, U32 batchSize )
+{
+    if ( itemCount == 0 )
+    {
+        return;
+    }
+
+    if ( batchSize == 0 )
+    {
+        batchSize = std::max( ( itemCount + _poolsPerFrame - 1 ) / _poolsPerFrame, kMinRecordBatchSize );
+    }
+    const auto batchCount = ( itemCount + batchSize - 1 ) / batchSize;
+    _peakBatchCount = std::max( _peakBatchCount, batchCount );
+    auto secondaryBuffers = std::pmr::vector<vk::CommandBuffer>( batchCount, _pResource );
+    auto exceptions = std::pmr::vector<std::exception_ptr>( batchCount, _pResource );
+
+    const auto recordBatch = [&]( U32 batch ) {
+        try
+        {
+            const auto& buffer = AcquireBuffer( GetThreadPool( _frameIndex ) );
+            buffer.Begin( inheritanceInfo );
+            record( buffer.commandBuffer, batch * batchSize, std::min( ( batch + 1 ) * batchSize, itemCount ) );
+            buffer.End();
+            secondaryBuffers[batch] = buffer.commandBuffer;
+        }
+        catch ( ... )
+        {
+            exceptions[batch] = std::current_exception();
+        }
+    };
+
+    if ( batchCount == 1 )
+    {
+        recordBatch( 0 );
+    }
+    else
+    {
+        // The last batch stays on this thread, it would otherwise sit idle waiting
+        auto done = std::latch( batchCount - 1 );
+        for ( U32 batch = 0; batch + 1 < batchCount; ++batch )
+        {
+            _threadPool.Submit( [&recordBatch, &done, batch]() {
+                recordBatch( batch );
+                done.count_down();
+            } );
+        }
+        recordBatch( batchCount - 1 );
+        done.wait();
+    }
+
+    for ( const auto& exception : exceptions )
+    {
+        if ( exception != nullptr )
+        {
+            std::rethrow_exception( exception );
+        }
+    }
+    primaryBuffer.executeCommands( secondaryBuffers );
+}
+
+void VulkanParallelRecorder::PrintStats() const
+{
+    auto bufferCount = size_t { 0 };
+    for ( const auto& threadPool : _pools )
+    {
+        bufferCount += threadPool.buffers.size();
+    }
+    WindDebug( "[[Parallel Recording]]" );
+    WindDebug( "\tCommand Pools: {} - Secondary Buffers: {} - Peak Batches Per Pass: {}", _pools.size(),
+               bufferCount, _peakBatchCount );
+}
+
+auto VulkanParallelRecorder::GetThreadPool( U32 frameIndex ) -> ThreadCommandPool&
+{
+    // Threads outside the worker pool share the last slot, only the thread calling Record is expected there
+    const auto workerIndex = ThreadPool::GetWorkerIndex();
+    const auto slot = workerIndex == kInvalidWorkerIndex ? _poolsPerFrame - 1 : workerIndex;
+    WindAssert( slot < _poolsPerFrame, "Worker index is outside the recorder pools." );
+    return _pools.at( static_cast<size_t>( frameIndex ) * _poolsPerFrame + slot );
+}
+
+auto VulkanParallelRecorder::AcquireBuffer( ThreadCommandPool& threadPool ) -> const VulkanCommandBuffer&
+{
+    if ( threadPool.usedCount == threadPool.buffers.size() )
+    {
+        threadPool.buffers.emplace_back().Allocate( _device->device, threadPool.pool, false );
+    }
+    return threadPool.buffers[threadPool.usedCount++];
+}
+
+}  // namespace WindEngine::Core::Render
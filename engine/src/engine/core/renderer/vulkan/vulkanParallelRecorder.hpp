@@ -0,0 +1,66 @@
+#ifndef WINDENGINE_VULKANPARALLELRECORDER_HPP
+#define WINDENGINE_VULKANPARALLELRECORDER_HPP
+
+#include "threadPool.hpp"
+#include "vulkanCommandBuffer.hpp"
+#include "vulkanHandle.hpp"
+#include <functional>
+#include <memory_resource>
+
+namespace WindEngine::Core::Render
+{
+
+// Below this many items per batch a secondary buffer costs more than recording the items on one thread
+constexpr U32 kMinRecordBatchSize = 64;
+
+// Records one render pass subpass from every worker thread at once. Each thread owns a command pool per frame in
+// flight, so recording never takes a lock, and the secondary buffers are executed from the primary buffer in the
+// order of the items they hold. The calling thread records a batch too. The thread pool should serve only recording,
+// a batch queued behind long running tasks stalls the frame. Not thread safe, Record is called from the thread
+// driving the frame.
+struct VulkanParallelRecorder : public VulkanHandle
+{
+    // Records items [begin, end) into a secondary buffer that has nothing bound yet. Must not throw.
+    using RecordFunction = std::function<void( const vk::CommandBuffer& commandBuffer, U32 begin, U32 end )>;
+
+    VulkanParallelRecorder( VulkanDevice& device, vk::AllocationCallbacks* allocator, ThreadPool& threadPool,
+                            std::pmr::memory_resource* pResource );
+
+    void Initialize( U32 framesInFlight );
+    void Destroy() override;
+
+    // Resets the pools of the frame slot in one call each, called once its fence was waited on
+    void BeginFrame( U32 frameIndex );
+
+    // The render pass has to be begun with vk::SubpassContents::eSecondaryCommandBuffers. Returns once every batch
+    // is recorded and executed from primaryBuffer. Without a batch size the items are split evenly across the
+    // workers and the calling thread, a single batch is recorded on the calling thread alone.
+    void Record( const vk::CommandBuffer& primaryBuffer, const vk::CommandBufferInheritanceInfo& inheritanceInfo,
+                 U32 itemCount, const RecordFunction& record, U32 batchSize = 0 );
+
+    void PrintStats() const;
+
+private:
+    struct ThreadCommandPool
+    {
+        vk::CommandPool pool {};
+        std::pmr::vector<VulkanCommandBuffer> buffers;
+        // Buffers handed out since the last reset
+        U32 usedCount {};
+    };
+
+    [[nodiscard]] auto GetThreadPool( U32 frameIndex ) -> ThreadCommandPool&;
+    [[nodiscard]] auto AcquireBuffer( ThreadCommandPool& threadPool ) -> const VulkanCommandBuffer&;
+
+    ThreadPool& _threadPool;
+    std::pmr::memory_resource* _pResource;
+    // framesInFlight rows of one pool per worker plus one for the calling thread
+    std::pmr::vector<ThreadCommandPool> _pools;
+    U32 _poolsPerFrame {};
+    U32 _frameIndex {};
+    U32 _peakBatchCount {};
+};
+
+}  // namespace WindEngine::Core::Render
+
+#endif  // WINDENGINE_VULKANPARALLELRECORDER_HPP
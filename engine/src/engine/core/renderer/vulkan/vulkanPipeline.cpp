@@ -1,19 +1,103 @@
 #include "vulkanPipeline.hpp"
+#include "assert.hpp"
 #include "logger.hpp"
+#include "mappedFile.hpp"
 #include "utils.hpp"
-#include <glm/vec3.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <vector>
 
 namespace WindEngine::Core::Render
 {
 
+auto VulkanPipelineDescription::Hash() const -> size_t
+{
+    auto seed = size_t { 0 };
+    G_HASH_COMBINE( seed, vertexShader );
+    G_HASH_COMBINE( seed, fragmentShader );
+    for ( U32 ind = 0; ind < vertexBindingCount; ++ind )
+    {
+        G_HASH_COMBINE( seed, vertexBindings.at( ind ).binding );
+        G_HASH_COMBINE( seed, vertexBindings.at( ind ).stride );
+        G_HASH_COMBINE( seed, vertexBindings.at( ind ).inputRate );
+    }
+    for ( U32 ind = 0; ind < vertexAttributeCount; ++ind )
+    {
+        G_HASH_COMBINE( seed, vertexAttributes.at( ind ).location );
+        G_HASH_COMBINE( seed, vertexAttributes.at( ind ).binding );
+        G_HASH_COMBINE( seed, vertexAttributes.at( ind ).format );
+        G_HASH_COMBINE( seed, vertexAttributes.at( ind ).offset );
+    }
+    G_HASH_COMBINE( seed, topology );
+    for ( U32 ind = 0; ind < specializationConstantCount; ++ind )
+    {
+        G_HASH_COMBINE( seed, specializationConstants.at( ind ).constantId );
+        G_HASH_COMBINE( seed, specializationConstants.at( ind ).value );
+    }
+    G_HASH_COMBINE( seed, polygonMode );
+    G_HASH_COMBINE( seed, static_cast<VkCullModeFlags>( cullMode ) );
+    G_HASH_COMBINE( seed, frontFace );
+    G_HASH_COMBINE( seed, depthTestEnable );
+    G_HASH_COMBINE( seed, depthWriteEnable );
+    G_HASH_COMBINE( seed, depthCompareOp );
+    G_HASH_COMBINE( seed, blendEnable );
+    G_HASH_COMBINE( seed, srcColorBlendFactor );
+    G_HASH_COMBINE( seed, dstColorBlendFactor );
+    G_HASH_COMBINE( seed, colorBlendOp );
+    G_HASH_COMBINE( seed, srcAlphaBlendFactor );
+    G_HASH_COMBINE( seed, dstAlphaBlendFactor );
+    G_HASH_COMBINE( seed, alphaBlendOp );
+    G_HASH_COMBINE( seed, static_cast<VkRenderPass>( renderPass ) );
+    G_HASH_COMBINE( seed, subpass );
+    return seed;
+}
+
+void VulkanPipelineDescription::SetSpecializationConstant( U32 constantId, U32 value )
+{
+    const auto begin = specializationConstants.begin();
+    const auto end = begin + specializationConstantCount;
+    auto found = std::lower_bound( begin, end, constantId, []( const VulkanSpecializationConstant& constant, U32 id ) {
+        return constant.constantId < id;
+    } );
+    if ( found != end && found->constantId == constantId )
+    {
+        found->value = value;
+        return;
+    }
+
+    WindAssert( specializationConstantCount < kMaxSpecializationConstants, "Too many specialization constants." );
+    std::move_backward( found, end, end + 1 );
+    *found = { .constantId = constantId, .value = value };
+    ++specializationConstantCount;
+}
+
+void VulkanPipelineDescription::SetSpecializationConstant( U32 constantId, I32 value )
+{
+    SetSpecializationConstant( constantId, std::bit_cast<U32>( value ) );
+}
+
+void VulkanPipelineDescription::SetSpecializationConstant( U32 constantId, F32 value )
+{
+    SetSpecializationConstant( constantId, std::bit_cast<U32>( value ) );
+}
+
+void VulkanPipelineDescription::SetSpecializationConstant( U32 constantId, bool value )
+{
+    SetSpecializationConstant( constantId, static_cast<U32>( value ? VK_TRUE : VK_FALSE ) );
+}
+
 VulkanPipeline::VulkanPipeline( VulkanDevice& device, vk::AllocationCallbacks* allocator )
   : VulkanHandle( &device, allocator )
 {
 }
 
-void VulkanPipeline::Initialize( const vk::RenderPass& renderPass )
+void VulkanPipeline::Initialize( const VulkanPipelineDescription& description,
+                                 const vk::PipelineLayout& pipelineLayout, const vk::PipelineCache& pipelineCache )
 {
-    InitializeShaderStage( "shaders/simple_vert.spv", "shaders/simple_frag.spv" );
+    _description = description;
+    InitializeSpecializationInfo();
+    InitializeShaderStage();
     InitializeVertexInputState();
     InitializeInputAssemblyState();
     InitializeViewportState();
@@ -23,8 +107,7 @@ void VulkanPipeline::Initialize( const vk::RenderPass& renderPass )
     InitializeColorBlendState();
     InitializeDynamicState();
 
-    const auto layoutInfo = vk::PipelineLayoutCreateInfo {};
-    _pipelineLayout = _device->device.createPipelineLayout( layoutInfo, _allocator );
+    _pipelineLayout = pipelineLayout;
 
     const auto pipelineInfo = vk::GraphicsPipelineCreateInfo {
         .stageCount = ToU32( _shaderInfos.size() ),
@@ -39,10 +122,12 @@ void VulkanPipeline::Initialize( const vk::RenderPass& renderPass )
         .pColorBlendState = &_colorBlendInfo,
         .pDynamicState = &_dynamicInfo,
         .layout = _pipelineLayout,
-        .renderPass = renderPass,
-        .subpass = 0,
+        .renderPass = _description.renderPass,
+        .subpass = _description.subpass,
     };
-    auto [result, graphicsPipeline] = _device->device.createGraphicsPipeline( nullptr, pipelineInfo, _allocator );
+    auto [result, graphicsPipeline] = _device->device.createGraphicsPipeline( pipelineCache, pipelineInfo, _allocator );
+    // The modules are not referenced once the pipeline exists
+    DestroyShaderModules();
     if ( result != vk::Result::eSuccess )
     {
         WindFatal( "Failed to create the pipeline." );
@@ -52,48 +137,61 @@ void VulkanPipeline::Initialize( const vk::RenderPass& renderPass )
 
 void VulkanPipeline::Destroy()
 {
-    for ( const auto& module : _shaderModules )
-    {
-        _device->device.destroy( module );
-    }
-    _device->device.destroy( _pipelineLayout, _allocator );
+    DestroyShaderModules();
     _device->device.destroy( _pipeline, _allocator );
+    _pipeline = nullptr;
 }
 
-void VulkanPipeline::InitializeShaderStage( const std::string& vertFile, const std::string& fragFile )
+void VulkanPipeline::InitializeSpecializationInfo()
+{
+    // The constants are read straight out of the description, each map entry points at one value field
+    const auto count = _description.specializationConstantCount;
+    constexpr auto kValueOffset = offsetof( VulkanSpecializationConstant, value );
+    for ( U32 ind = 0; ind < count; ++ind )
+    {
+        _specializationEntries.at( ind ) = {
+            .constantID = _description.specializationConstants.at( ind ).constantId,
+            .offset = ToU32( ind * sizeof( VulkanSpecializationConstant ) + kValueOffset ),
+            .size = sizeof( U32 ),
+        };
+    }
+    _specializationInfo = { .mapEntryCount = count,
+                            .pMapEntries = _specializationEntries.data(),
+                            .dataSize = count * sizeof( VulkanSpecializationConstant ),
+                            .pData = _description.specializationConstants.data() };
+}
 
+void VulkanPipeline::InitializeShaderStage()
 {
-    _shaderModules = { CreateShaderModule( vertFile ), CreateShaderModule( fragFile ) };
+    // One at a time, so the modules created before a failing one are still destroyed
+    _shaderModules.push_back( CreateShaderModule( _description.vertexShader ) );
+    _shaderModules.push_back( CreateShaderModule( _description.fragmentShader ) );
+    const auto* pSpecializationInfo = _description.specializationConstantCount == 0 ? nullptr : &_specializationInfo;
     const auto vertInfo = vk::PipelineShaderStageCreateInfo { .stage = vk::ShaderStageFlagBits::eVertex,
                                                               .module = _shaderModules.at( 0 ),
                                                               .pName = "main",
-                                                              .pSpecializationInfo = nullptr };
+                                                              .pSpecializationInfo = pSpecializationInfo };
     const auto fragInfo = vk::PipelineShaderStageCreateInfo { .stage = vk::ShaderStageFlagBits::eFragment,
                                                               .module = _shaderModules.at( 1 ),
                                                               .pName = "main",
-                                                              .pSpecializationInfo = nullptr };
+                                                              .pSpecializationInfo = pSpecializationInfo };
     _shaderInfos = { vertInfo, fragInfo };
 }
 
 void VulkanPipeline::InitializeVertexInputState()
 {
-    static const auto bindingDesc = vk::VertexInputBindingDescription { .binding = 0,
-                                                                        .stride = sizeof( glm::vec3 ) * 2,
-                                                                        .inputRate = vk::VertexInputRate::eVertex };
-    static const std::vector<vk::VertexInputAttributeDescription> attributeDesc {
-        { .location = 0, .binding = 0, .format = vk::Format::eR32G32B32Sfloat, .offset = 0 },
-        { .location = 1, .binding = 0, .format = vk::Format::eR32G32B32Sfloat, .offset = sizeof( glm::vec3 ) }
-    };
-
-    _vertexInputInfo = { .vertexBindingDescriptionCount = 1,
-                         .pVertexBindingDescriptions = &bindingDesc,
-                         .vertexAttributeDescriptionCount = ToU32( attributeDesc.size() ),
-                         .pVertexAttributeDescriptions = attributeDesc.data() };
+    WindAssert( _description.vertexBindingCount <= kMaxVertexBindings &&
+                  _description.vertexAttributeCount <= kMaxVertexAttributes,
+                "Too many vertex inputs." );
+    _vertexInputInfo = { .vertexBindingDescriptionCount = _description.vertexBindingCount,
+                         .pVertexBindingDescriptions = _description.vertexBindings.data(),
+                         .vertexAttributeDescriptionCount = _description.vertexAttributeCount,
+                         .pVertexAttributeDescriptions = _description.vertexAttributes.data() };
 }
 
 void VulkanPipeline::InitializeInputAssemblyState()
 {
-    _inputAssemblyInfo = { .topology = vk::PrimitiveTopology::eTriangleList, .primitiveRestartEnable = VK_FALSE };
+    _inputAssemblyInfo = { .topology = _description.topology, .primitiveRestartEnable = VK_FALSE };
 }
 
 void VulkanPipeline::InitializeViewportState()
@@ -105,9 +203,9 @@ void VulkanPipeline::InitializeRasterizationState()
 {
     _rasterizationInfo = { .depthClampEnable = VK_FALSE,
                            .rasterizerDiscardEnable = VK_FALSE,
-                           .polygonMode = vk::PolygonMode::eFill,
-                           .cullMode = vk::CullModeFlagBits::eBack,
-                           .frontFace = vk::FrontFace::eCounterClockwise,
+                           .polygonMode = _description.polygonMode,
+                           .cullMode = _description.cullMode,
+                           .frontFace = _description.frontFace,
                            .depthBiasEnable = VK_FALSE,
                            .depthBiasConstantFactor = 0.0F,
                            .depthBiasClamp = 0.0F,
@@ -128,9 +226,9 @@ void VulkanPipeline::InitializeMultisampleState()
 void VulkanPipeline::InitializeDepthStencilState()
 {
     _depthStencilInfo = {
-        .depthTestEnable = VK_TRUE,
-        .depthWriteEnable = VK_TRUE,
-        .depthCompareOp = vk::CompareOp::eLessOrEqual,
+        .depthTestEnable = static_cast<vk::Bool32>( _description.depthTestEnable ),
+        .depthWriteEnable = static_cast<vk::Bool32>( _description.depthWriteEnable ),
+        .depthCompareOp = _description.depthCompareOp,
         .depthBoundsTestEnable = VK_FALSE,
         .stencilTestEnable = VK_FALSE,
         .front = {},
@@ -142,22 +240,20 @@ void VulkanPipeline::InitializeDepthStencilState()
 
 void VulkanPipeline::InitializeColorBlendState()
 {
-    static const auto colorAttachment =
-      vk::PipelineColorBlendAttachmentState { .blendEnable = VK_FALSE,
-                                              .srcColorBlendFactor = vk::BlendFactor::eOne,
-                                              .dstColorBlendFactor = vk::BlendFactor::eOne,
-                                              .colorBlendOp = vk::BlendOp::eAdd,
-                                              .srcAlphaBlendFactor = vk::BlendFactor::eOne,
-                                              .dstAlphaBlendFactor = vk::BlendFactor::eOne,
-                                              .alphaBlendOp = vk::BlendOp::eMin,
-                                              .colorWriteMask =
-                                                vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG |
-                                                vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA };
+    _colorAttachment = { .blendEnable = static_cast<vk::Bool32>( _description.blendEnable ),
+                         .srcColorBlendFactor = _description.srcColorBlendFactor,
+                         .dstColorBlendFactor = _description.dstColorBlendFactor,
+                         .colorBlendOp = _description.colorBlendOp,
+                         .srcAlphaBlendFactor = _description.srcAlphaBlendFactor,
+                         .dstAlphaBlendFactor = _description.dstAlphaBlendFactor,
+                         .alphaBlendOp = _description.alphaBlendOp,
+                         .colorWriteMask = vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG |
+                                           vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA };
     const auto blendConstants = std::array<float, 4> { 0.0F, 0.0F, 0.0F, 0.0F };  // TODO(emreaydn): Try this
     _colorBlendInfo = { .logicOpEnable = VK_FALSE,
                         .logicOp = vk::LogicOp::eCopy,
                         .attachmentCount = 1,
-                        .pAttachments = &colorAttachment,
+                        .pAttachments = &_colorAttachment,
                         .blendConstants = blendConstants };
 }
 
@@ -168,10 +264,33 @@ void VulkanPipeline::InitializeDynamicState()
     _dynamicInfo = { .dynamicStateCount = ToU32( dynamicStates.size() ), .pDynamicStates = dynamicStates.data() };
 }
 
+void VulkanPipeline::DestroyShaderModules()
+{
+    for ( const auto& module : _shaderModules )
+    {
+        _device->device.destroy( module, _allocator );
+    }
+    _shaderModules.clear();
+    _shaderInfos.clear();
+}
+
 auto VulkanPipeline::CreateShaderModule( const std::string& file ) -> vk::ShaderModule
 {
-    const auto shaderCode = G_READ_SHADER_FROM_FILE<U32>( file );
-    const auto shaderInfo = vk::ShaderModuleCreateInfo { .codeSize = shaderCode.size(), .pCode = shaderCode.data() };
+    // The driver consumes the mapped pages directly, the mapping is page aligned so it can be read as U32 words
+    Memory::MappedFile shaderFile;
+    if ( !shaderFile.Open( file, { .populate = true } ) )
+    {
+        throw std::runtime_error( fmt::format( "Failed to read shader {}.", file ) );
+    }
+    const auto shaderCode = shaderFile.GetData();
+    if ( shaderCode.empty() || shaderCode.size() % sizeof( U32 ) != 0 )
+    {
+        throw std::runtime_error( fmt::format( "{} is not a SPIR-V binary.", file ) );
+    }
+    const auto shaderInfo = vk::ShaderModuleCreateInfo {
+        .codeSize = shaderCode.size(),
+        .pCode = reinterpret_cast<const U32*>( shaderCode.data() ),
+    };
     return _device->device.createShaderModule( shaderInfo, _allocator );
 }
 
@@ -185,4 +304,9 @@ auto VulkanPipeline::GetPipelineLayout() const -> const vk::PipelineLayout&
     return _pipelineLayout;
 }
 
+auto VulkanPipeline::GetDescription() const -> const VulkanPipelineDescription&
+{
+    return _description;
+}
+
 }  // namespace WindEngine::Core::Render
@@ -2,23 +2,101 @@
 #define WINDENGINE_VULKANPIPELINE_HPP
 
 #include "vulkanHandle.hpp"
+#include <array>
+#include <string>
 
 namespace WindEngine::Core::Render
 {
 
+constexpr U32 kMaxVertexBindings = 4;
+constexpr U32 kMaxVertexAttributes = 16;
+constexpr U32 kMaxSpecializationConstants = 16;
+
+// Every constant is 32 bits wide, bools are VkBool32 and floats are stored as their bit pattern
+struct VulkanSpecializationConstant
+{
+    U32 constantId {};
+    U32 value {};
+
+    auto operator==( const VulkanSpecializationConstant& other ) const -> bool = default;
+};
+
+// Everything a graphics pipeline is built from. Vertex inputs live in fixed arrays so the whole description can be
+// compared and hashed by value, identical requests then map to one pipeline.
+struct VulkanPipelineDescription
+{
+    std::string vertexShader;
+    std::string fragmentShader;
+
+    std::array<vk::VertexInputBindingDescription, kMaxVertexBindings> vertexBindings {};
+    U32 vertexBindingCount {};
+    std::array<vk::VertexInputAttributeDescription, kMaxVertexAttributes> vertexAttributes {};
+    U32 vertexAttributeCount {};
+    vk::PrimitiveTopology topology { vk::PrimitiveTopology::eTriangleList };
+
+    // Handed to every stage, a stage ignores the ids it does not declare. Kept sorted by id so the order they are set
+    // in does not create a new variant.
+    std::array<VulkanSpecializationConstant, kMaxSpecializationConstants> specializationConstants {};
+    U32 specializationConstantCount {};
+
+    vk::PolygonMode polygonMode { vk::PolygonMode::eFill };
+    vk::CullModeFlags cullMode { vk::CullModeFlagBits::eBack };
+    vk::FrontFace frontFace { vk::FrontFace::eCounterClockwise };
+
+    bool depthTestEnable { true };
+    bool depthWriteEnable { true };
+    vk::CompareOp depthCompareOp { vk::CompareOp::eLessOrEqual };
+
+    bool blendEnable { false };
+    vk::BlendFactor srcColorBlendFactor { vk::BlendFactor::eOne };
+    vk::BlendFactor dstColorBlendFactor { vk::BlendFactor::eZero };
+    vk::BlendOp colorBlendOp { vk::BlendOp::eAdd };
+    vk::BlendFactor srcAlphaBlendFactor { vk::BlendFactor::eOne };
+    vk::BlendFactor dstAlphaBlendFactor { vk::BlendFactor::eZero };
+    vk::BlendOp alphaBlendOp { vk::BlendOp::eAdd };
+
+    // The pipeline can be used with any render pass compatible with this one
+    vk::RenderPass renderPass {};
+    U32 subpass {};
+
+    // Overrides the default value declared in the shader
+    void SetSpecializationConstant( U32 constantId, U32 value );
+    void SetSpecializationConstant( U32 constantId, I32 value );
+    void SetSpecializationConstant( U32 constantId, F32 value );
+    void SetSpecializationConstant( U32 constantId, bool value );
+
+    auto operator==( const VulkanPipelineDescription& other ) const -> bool = default;
+
+    [[nodiscard]] auto Hash() const -> size_t;
+};
+
+struct VulkanPipelineDescriptionHash
+{
+    auto operator()( const VulkanPipelineDescription& description ) const -> size_t
+    {
+        return description.Hash();
+    }
+};
+
 struct VulkanPipeline : public VulkanHandle
 {
     VulkanPipeline( VulkanDevice& device, vk::AllocationCallbacks* allocator );
 
-    void Initialize( const vk::RenderPass& renderPass );
+    // The layout is shared between pipelines and owned by its creator. Safe to call from any thread, pipelines
+    // compile in parallel against the same cache.
+    void Initialize( const VulkanPipelineDescription& description, const vk::PipelineLayout& pipelineLayout,
+                     const vk::PipelineCache& pipelineCache );
     void Destroy() override;
 
     [[nodiscard]] auto GetPipeline() const -> const vk::Pipeline&;
 
     [[nodiscard]] auto GetPipelineLayout() const -> const vk::PipelineLayout&;
 
+    [[nodiscard]] auto GetDescription() const -> const VulkanPipelineDescription&;
+
 private:
-    void InitializeShaderStage( const std::string& vertFile, const std::string& fragFile );
+    void InitializeSpecializationInfo();
+    void InitializeShaderStage();
     void InitializeVertexInputState();
     void InitializeInputAssemblyState();
     void InitializeViewportState();
@@ -27,9 +105,11 @@ private:
     void InitializeDepthStencilState();
     void InitializeColorBlendState();
     void InitializeDynamicState();
+    void DestroyShaderModules();
 
     [[nodiscard]] auto CreateShaderModule( const std::string& file ) -> vk::ShaderModule;
 
+    VulkanPipelineDescription _description;
     vk::PipelineLayout _pipelineLayout;
     vk::Pipeline _pipeline;
     std::vector<vk::ShaderModule> _shaderModules;
@@ -40,6 +120,9 @@ private:
     vk::PipelineRasterizationStateCreateInfo _rasterizationInfo {};
     vk::PipelineMultisampleStateCreateInfo _multisampleInfo {};
     vk::PipelineDepthStencilStateCreateInfo _depthStencilInfo {};
+    std::array<vk::SpecializationMapEntry, kMaxSpecializationConstants> _specializationEntries {};
+    vk::SpecializationInfo _specializationInfo {};
+    vk::PipelineColorBlendAttachmentState _colorAttachment {};
     vk::PipelineColorBlendStateCreateInfo _colorBlendInfo {};
     vk::PipelineDynamicStateCreateInfo _dynamicInfo {};
 };
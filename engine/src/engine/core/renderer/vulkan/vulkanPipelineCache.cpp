@@ -0,0 +1,164 @@
+#include "vulkanPipelineCache.hpp"
+#include "logger.hpp"
+#include "mappedFile.hpp"
+#include <cstring>
+
+#if defined( _WIN32 )
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace WindEngine::Core::Render
+{
+
+namespace
+{
+
+// Returns once the data is on disk, not just in the page cache, so a rename after it can not land first
+#if defined( _WIN32 )
+auto WriteFileDurably( const std::filesystem::path& path, std::span<const U8> data ) -> bool
+{
+    auto* fileHandle =
+      CreateFileW( path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr );
+    if ( fileHandle == INVALID_HANDLE_VALUE )
+    {
+        return false;
+    }
+    DWORD written = 0;
+    const auto isWritten = WriteFile( fileHandle, data.data(), static_cast<DWORD>( data.size() ), &written, nullptr ) &&
+                           written == data.size() && FlushFileBuffers( fileHandle );
+    CloseHandle( fileHandle );
+    return isWritten;
+}
+
+auto ReplaceFileDurably( const std::filesystem::path& from, const std::filesystem::path& to ) -> bool
+{
+    return MoveFileExW( from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH ) != 0;
+}
+#else
+auto WriteFileDurably( const std::filesystem::path& path, std::span<const U8> data ) -> bool
+{
+    const auto fileDescriptor = open( path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644 );
+    if ( fileDescriptor < 0 )
+    {
+        return false;
+    }
+    size_t written = 0;
+    while ( written < data.size() )
+    {
+        const auto result = write( fileDescriptor, data.data() + written, data.size() - written );
+        if ( result < 0 && errno == EINTR )
+        {
+            continue;
+        }
+        if ( result <= 0 )
+        {
+            break;
+        }
+        written += static_cast<size_t>( result );
+    }
+    const auto isWritten = written == data.size() && fsync( fileDescriptor ) == 0;
+    close( fileDescriptor );
+    return isWritten;
+}
+
+// The rename is only durable once the directory entry is synced as well
+auto ReplaceFileDurably( const std::filesystem::path& from, const std::filesystem::path& to ) -> bool
+{
+    if ( rename( from.c_str(), to.c_str() ) != 0 )
+    {
+        return false;
+    }
+    const auto directory = to.has_parent_path() ? to.parent_path() : std::filesystem::path( "." );
+    const auto directoryDescriptor = open( directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC );
+    if ( directoryDescriptor < 0 )
+    {
+        return false;
+    }
+    const auto isSynced = fsync( directoryDescriptor ) == 0;
+    close( directoryDescriptor );
+    return isSynced;
+}
+#endif
+
+}  // namespace
+
+VulkanPipelineCache::VulkanPipelineCache( VulkanDevice& device, vk::AllocationCallbacks* allocator )
+  : VulkanHandle( &device, allocator )
+{
+}
+
+void VulkanPipelineCache::Initialize( const std::filesystem::path& path )
+{
+    _path = path;
+
+    auto data = std::span<const std::byte> {};
+    Memory::MappedFile file;
+    if ( std::filesystem::exists( _path ) && file.Open( _path ) )
+    {
+        data = file.GetData();
+        if ( !IsCompatible( data ) )
+        {
+            WindInfo( "Pipeline cache {} is unreadable or from another device, starting empty.", _path.string() );
+            data = {};
+        }
+    }
+
+    const auto cacheInfo = vk::PipelineCacheCreateInfo { .initialDataSize = data.size(), .pInitialData = data.data() };
+    _pipelineCache = _device->device.createPipelineCache( cacheInfo, _allocator );
+    WindInfo( "Pipeline cache created with {} bytes of initial data.", data.size() );
+}
+
+void VulkanPipelineCache::Destroy()
+{
+    _device->device.destroy( _pipelineCache, _allocator );
+}
+
+void VulkanPipelineCache::Save() const
+{
+    const auto data = _device->device.getPipelineCacheData( _pipelineCache );
+
+    auto tempPath = _path;
+    tempPath += ".tmp";
+    std::error_code error;
+    if ( !WriteFileDurably( tempPath, data ) )
+    {
+        WindWarn( "Failed to write the pipeline cache to {}.", tempPath.string() );
+        std::filesystem::remove( tempPath, error );
+        return;
+    }
+
+    // The data is synced before the rename, which is atomic, so readers see either the old or the new cache
+    if ( !ReplaceFileDurably( tempPath, _path ) )
+    {
+        WindWarn( "Failed to replace {}.", _path.string() );
+        std::filesystem::remove( tempPath, error );
+        return;
+    }
+    WindInfo( "Saved {} bytes of pipeline cache to {}.", data.size(), _path.string() );
+}
+
+auto VulkanPipelineCache::GetPipelineCache() const -> const vk::PipelineCache&
+{
+    return _pipelineCache;
+}
+
+auto VulkanPipelineCache::IsCompatible( std::span<const std::byte> data ) const -> bool
+{
+    VkPipelineCacheHeaderVersionOne header {};
+    if ( data.size() < sizeof( header ) )
+    {
+        return false;
+    }
+    memcpy( &header, data.data(), sizeof( header ) );
+
+    const auto& properties = _device->physicalDeviceInfo.properties;
+    return header.headerSize >= sizeof( header ) && header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == properties.vendorID && header.deviceID == properties.deviceID &&
+           memcmp( header.pipelineCacheUUID, properties.pipelineCacheUUID.data(), VK_UUID_SIZE ) == 0;
+}
+
+}  // namespace WindEngine::Core::Render
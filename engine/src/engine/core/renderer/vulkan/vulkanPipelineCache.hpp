@@ -0,0 +1,37 @@
+#ifndef WINDENGINE_VULKANPIPELINECACHE_HPP
+#define WINDENGINE_VULKANPIPELINECACHE_HPP
+
+#include "vulkanHandle.hpp"
+#include <filesystem>
+#include <span>
+
+namespace WindEngine::Core::Render
+{
+
+constexpr auto kPipelineCacheFileName = "pipeline_cache.bin";
+
+// vk::PipelineCache backed by a file. The file is only used when its header was written by the same driver for the
+// same device, anything else starts with an empty cache.
+struct VulkanPipelineCache : public VulkanHandle
+{
+    VulkanPipelineCache( VulkanDevice& device, vk::AllocationCallbacks* allocator );
+
+    void Initialize( const std::filesystem::path& path );
+    void Destroy() override;
+
+    // Writes and syncs a temporary file, then renames it over the old one and syncs the directory. Neither a crash nor
+    // a power loss mid-write leaves a torn cache behind.
+    void Save() const;
+
+    [[nodiscard]] auto GetPipelineCache() const -> const vk::PipelineCache&;
+
+private:
+    [[nodiscard]] auto IsCompatible( std::span<const std::byte> data ) const -> bool;
+
+    std::filesystem::path _path;
+    vk::PipelineCache _pipelineCache {};
+};
+
+}  // namespace WindEngine::Core::Render
+
+#endif  // WINDENGINE_VULKANPIPELINECACHE_HPP
@@ -0,0 +1,142 @@
+#include "vulkanPipelineManager.hpp"
+#include "assert.hpp"
+#include "logger.hpp"
+#include <chrono>
+
+namespace WindEngine::Core::Render
+{
+
+VulkanPipelineManager::VulkanPipelineManager( VulkanDevice& device, vk::AllocationCallbacks* allocator,
+                                              ThreadPool& threadPool, std::pmr::memory_resource* pResource )
+  : VulkanHandle( &device, allocator ), _threadPool( threadPool ), _entries( pResource ), _handles( pResource )
+{
+}
+
+void VulkanPipelineManager::Initialize( const VulkanPipelineDescription& defaultDescription,
+                                        const vk::PipelineLayout& pipelineLayout,
+                                        const vk::PipelineCache& pipelineCache )
+{
+    _pipelineLayout = pipelineLayout;
+    _pipelineCache = pipelineCache;
+
+    const std::scoped_lock lock( _mutex );
+    auto& entry = *_entries.emplace_back( std::make_unique<PipelineEntry>() );
+    _handles.emplace( defaultDescription, kDefaultPipelineHandle );
+    Compile( entry, defaultDescription );
+    if ( entry.status.load( std::memory_order_acquire ) != PipelineStatus::READY )
+    {
+        WindFatal( "Failed to compile the default pipeline." );
+    }
+}
+
+void VulkanPipelineManager::Destroy()
+{
+    // The pool may be shared, so this also waits for unrelated tasks
+    _threadPool.WaitIdle();
+
+    const std::scoped_lock lock( _mutex );
+    for ( const auto& upEntry : _entries )
+    {
+        if ( upEntry->upPipeline != nullptr )
+        {
+            upEntry->upPipeline->Destroy();
+        }
+    }
+    _entries.clear();
+    _handles.clear();
+}
+
+auto VulkanPipelineManager::Request( const VulkanPipelineDescription& description ) -> PipelineHandle
+{
+    const std::scoped_lock lock( _mutex );
+    ++_requestCount;
+    if ( const auto found = _handles.find( description ); found != _handles.end() )
+    {
+        return found->second;
+    }
+
+    const auto handle = static_cast<PipelineHandle>( _entries.size() );
+    auto* pEntry = _entries.emplace_back( std::make_unique<PipelineEntry>() ).get();
+    _handles.emplace( description, handle );
+    _threadPool.Submit( [this, pEntry, description]() { Compile( *pEntry, description ); } );
+    WindTrace( "Queued pipeline {} for {} and {} with {} specialization constants.", handle, description.vertexShader,
+               description.fragmentShader, description.specializationConstantCount );
+    return handle;
+}
+
+auto VulkanPipelineManager::GetStatus( PipelineHandle handle ) const -> PipelineStatus
+{
+    return GetEntry( handle ).status.load( std::memory_order_acquire );
+}
+
+auto VulkanPipelineManager::GetPipeline( PipelineHandle handle ) const -> const vk::Pipeline&
+{
+    const auto& entry = GetEntry( handle );
+    if ( entry.status.load( std::memory_order_acquire ) == PipelineStatus::READY )
+    {
+        return entry.upPipeline->GetPipeline();
+    }
+    return GetEntry( kDefaultPipelineHandle ).upPipeline->GetPipeline();
+}
+
+auto VulkanPipelineManager::TryGetPipeline( PipelineHandle handle ) const -> std::optional<vk::Pipeline>
+{
+    const auto& entry = GetEntry( handle );
+    if ( entry.status.load( std::memory_order_acquire ) == PipelineStatus::READY )
+    {
+        return entry.upPipeline->GetPipeline();
+    }
+    return std::nullopt;
+}
+
+void VulkanPipelineManager::PrintStats() const
+{
+    const std::scoped_lock lock( _mutex );
+    const auto compiledCount = _compiledCount.load( std::memory_order_relaxed );
+    const auto averageMilliseconds =
+      compiledCount == 0
+        ? 0.0
+        : static_cast<double>( _compileMicroseconds.load( std::memory_order_relaxed ) ) / compiledCount / 1000.0;
+    WindDebug( "[[Pipelines]]" );
+    WindDebug( "\tPipelines: {} - Requests: {} - Failed: {}", _entries.size(), _requestCount,
+               _failedCount.load( std::memory_order_relaxed ) );
+    WindDebug( "\tAverage Compile Time: {:.2f} ms on {} workers", averageMilliseconds,
+               _threadPool.GetThreadCount() );
+}
+
+void VulkanPipelineManager::Compile( PipelineEntry& entry, const VulkanPipelineDescription& description )
+{
+    const auto start = std::chrono::steady_clock::now();
+    auto upPipeline = std::make_unique<VulkanPipeline>( *_device, _allocator );
+    try
+    {
+        upPipeline->Initialize( description, _pipelineLayout, _pipelineCache );
+    }
+    catch ( const std::exception& exception )
+    {
+        // Whatever was created before the failure
+        upPipeline->Destroy();
+        WindError( "Failed to compile the pipeline for {} and {}. {}", description.vertexShader,
+                   description.fragmentShader, exception.what() );
+        _failedCount.fetch_add( 1, std::memory_order_relaxed );
+        entry.status.store( PipelineStatus::FAILED, std::memory_order_release );
+        return;
+    }
+
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    _compileMicroseconds.fetch_add(
+      static_cast<U64>( std::chrono::duration_cast<std::chrono::microseconds>( elapsed ).count() ),
+      std::memory_order_relaxed );
+    _compiledCount.fetch_add( 1, std::memory_order_relaxed );
+    entry.upPipeline = std::move( upPipeline );
+    entry.status.store( PipelineStatus::READY, std::memory_order_release );
+}
+
+auto VulkanPipelineManager::GetEntry( PipelineHandle handle ) const -> const PipelineEntry&
+{
+    const std::scoped_lock lock( _mutex );
+    WindAssert( handle < _entries.size(), "Unknown pipeline handle." );
+    return *_entries[handle];
+}
+
+}  // namespace WindEngine::Core::Render
@@ -0,0 +1,79 @@
+#ifndef WINDENGINE_VULKANPIPELINEMANAGER_HPP
+#define WINDENGINE_VULKANPIPELINEMANAGER_HPP
+
+#include "threadPool.hpp"
+#include "vulkanHandle.hpp"
+#include "vulkanPipeline.hpp"
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace WindEngine::Core::Render
+{
+
+using PipelineHandle = U32;
+// Compiled on Initialize, drawn with while other pipelines compile
+constexpr PipelineHandle kDefaultPipelineHandle = 0;
+
+enum class PipelineStatus : U32
+{
+    COMPILING = 0,
+    READY = 1,
+    FAILED = 2
+};
+
+// Owns every graphics pipeline. Requests are deduplicated by description and new ones compile on worker threads
+// against the shared pipeline cache, so a material showing up mid-session never stalls a frame. Until its pipeline
+// is ready a draw either uses the default pipeline or is skipped. Thread safe.
+struct VulkanPipelineManager : public VulkanHandle
+{
+    VulkanPipelineManager( VulkanDevice& device, vk::AllocationCallbacks* allocator, ThreadPool& threadPool,
+                           std::pmr::memory_resource* pResource );
+
+    // The default pipeline compiles on the calling thread, a failure there is fatal
+    void Initialize( const VulkanPipelineDescription& defaultDescription, const vk::PipelineLayout& pipelineLayout,
+                     const vk::PipelineCache& pipelineCache );
+    // Waits for the compilations still running
+    void Destroy() override;
+
+    // Returns immediately, compilation is queued the first time a description is seen
+    [[nodiscard]] auto Request( const VulkanPipelineDescription& description ) -> PipelineHandle;
+
+    [[nodiscard]] auto GetStatus( PipelineHandle handle ) const -> PipelineStatus;
+    // The default pipeline until the requested one is ready, or if it failed to compile
+    [[nodiscard]] auto GetPipeline( PipelineHandle handle ) const -> const vk::Pipeline&;
+    // Empty until the requested pipeline is ready, for draws that are better skipped than drawn wrong
+    [[nodiscard]] auto TryGetPipeline( PipelineHandle handle ) const -> std::optional<vk::Pipeline>;
+
+    void PrintStats() const;
+
+private:
+    struct PipelineEntry
+    {
+        std::unique_ptr<VulkanPipeline> upPipeline;
+        std::atomic<PipelineStatus> status { PipelineStatus::COMPILING };
+    };
+
+    void Compile( PipelineEntry& entry, const VulkanPipelineDescription& description );
+    [[nodiscard]] auto GetEntry( PipelineHandle handle ) const -> const PipelineEntry&;
+
+    ThreadPool& _threadPool;
+    vk::PipelineLayout _pipelineLayout {};
+    vk::PipelineCache _pipelineCache {};
+    // Entries never move, workers hold on to them while the vector grows
+    std::pmr::vector<std::unique_ptr<PipelineEntry>> _entries;
+    std::pmr::unordered_map<VulkanPipelineDescription, PipelineHandle, VulkanPipelineDescriptionHash> _handles;
+    mutable std::mutex _mutex;
+
+    U64 _requestCount {};
+    std::atomic<U32> _compiledCount {};
+    std::atomic<U32> _failedCount {};
+    std::atomic<U64> _compileMicroseconds {};
+};
+
+}  // namespace WindEngine::Core::Render
+
+#endif  // WINDENGINE_VULKANPIPELINEMANAGER_HPP
@@ -72,7 +72,8 @@ void VulkanRenderPass::Destroy()
 
 void VulkanRenderPass::BeginRenderPass( const vk::CommandBuffer& commandBuffer, const vk::Framebuffer& framebuffer,
                                         const vk::Rect2D& renderArea, const vk::ClearColorValue& colorValue,
-                                        const vk::ClearDepthStencilValue& depthStencilValue )
+                                        const vk::ClearDepthStencilValue& depthStencilValue,
+                                        vk::SubpassContents contents )
 {
     auto clearValues = std::array<vk::ClearValue, 2> { vk::ClearValue { .color = colorValue },
                                                        vk::ClearValue { .depthStencil = depthStencilValue } };
@@ -85,7 +86,7 @@ void VulkanRenderPass::BeginRenderPass( const vk::CommandBuffer& commandBuffer,
     };
 
     _commandBuffer = commandBuffer;
-    _commandBuffer.beginRenderPass( beginInfo, vk::SubpassContents::eInline );
+    _commandBuffer.beginRenderPass( beginInfo, contents );
 }
 
 void VulkanRenderPass::EndRenderPass()
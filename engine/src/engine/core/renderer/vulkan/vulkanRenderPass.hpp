@@ -18,7 +18,8 @@ struct VulkanRenderPass : public VulkanHandle
 
     void BeginRenderPass( const vk::CommandBuffer& commandBuffer, const vk::Framebuffer& framebuffer,
                           const vk::Rect2D& renderArea, const vk::ClearColorValue& colorValue,
-                          const vk::ClearDepthStencilValue& depthStencilValue );
+                          const vk::ClearDepthStencilValue& depthStencilValue,
+                          vk::SubpassContents contents = vk::SubpassContents::eInline );
     void EndRenderPass();
 
     [[nodiscard]] auto GetRenderPass() const -> vk::RenderPass;
@@ -1,11 +1,17 @@
 #include "vulkanRenderer.hpp"
 #include <SDL_vulkan.h>
+#include <cmath>
+#include <cstring>
 
 VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
 
 namespace WindEngine::Core::Render
 {
 
+VulkanRenderer::VulkanRenderer( Memory::AllocationManager& allocationManager ) : _context( allocationManager )
+{
+}
+
 auto VulkanRenderer::Initialize( const AppConfig& config ) -> bool
 {
     // Initialize the vulkan-hpp dispatcher
@@ -13,7 +19,7 @@ auto VulkanRenderer::Initialize( const AppConfig& config ) -> bool
     auto vkGetInstanceProcAddr = dynamicLoader.getProcAddress<PFN_vkGetInstanceProcAddr>( "vkGetInstanceProcAddr" );
     VULKAN_HPP_DEFAULT_DISPATCHER.init( vkGetInstanceProcAddr );
 
-    return _context.Initialize( config.appName.c_str(), config.width, config.height );
+    return _context.Initialize( config.appName.c_str(), config.width, config.height, config.framesInFlight );
 }
 
 void VulkanRenderer::Shutdown()
@@ -23,15 +29,31 @@ void VulkanRenderer::Shutdown()
     SDL_DestroyWindow( _context.window );
 }
 
-auto VulkanRenderer::BeginFrame( AppState& state ) -> bool
+auto VulkanRenderer::WaitForFrame( AppState& state ) -> bool
 {
-    auto frame = _context.GetCurrentFrame();
+    auto& frame = _context.GetCurrentFrame();
+    const auto waitStart = SDL_GetPerformanceCounter();
     const auto result = _context.GetDevice().waitForFences( frame.fence, VK_TRUE, std::numeric_limits<U64>::max() );
+    state.frameStats.totalFenceWait += AppState::GetMillisecondsSince( waitStart );
     if ( result != vk::Result::eTimeout && result != vk::Result::eSuccess )
     {
         WindError( "vkWaitForFences Error" );
         return false;
     }
+    // The fence covers everything the frame slot submitted, so all of its per-frame resources are free again
+    const auto frameIndex = _context.GetCurrentFrameIndex();
+    frame.Reset( _context.GetDevice() );
+    _context.uploadRing.BeginFrame( frameIndex );
+    _context.descriptorAllocator.BeginFrame( frameIndex );
+    _context.parallelRecorder.BeginFrame( frameIndex );
+    _context.device.memoryAllocator.UpdateBudgets();
+    _context.bindless.BeginFrame( _context.currentFrame );
+    return true;
+}
+
+auto VulkanRenderer::BeginFrame( AppState& state ) -> bool
+{
+    auto& frame = _context.GetCurrentFrame();
 
     if ( state.shouldResize )
     {
@@ -56,48 +78,130 @@ auto VulkanRenderer::BeginFrame( AppState& state ) -> bool
     _context.GetDevice().resetFences( frame.fence );
 
     _context.imageIndex = *optionalImageIndex;
-    const auto& cmd = _context.graphicsCommandBuffers[_context.imageIndex];
+    const auto& cmd = frame.commandBuffer;
     const auto& framebuffer = _context.framebuffers[_context.imageIndex];
     cmd.Begin();
 
+    // Uploads recorded since the last frame are submitted now so this frame can wait on them. The sample texture
+    // is reported as covering the whole framebuffer, so it streams in up to its finest level.
+    _context.textureStreamer.ReportUsage( _context.sampleTexture,
+                                          static_cast<F32>( std::max( _context.framebufferWidth,
+                                                                      _context.framebufferHeight ) ) );
+    _context.textureStreamer.Update( _context.currentFrame, frame.deletionQueue );
+    _context.uploader.Submit();
+    _context.uploader.RecordAcquireBarriers( cmd.commandBuffer );
+
+    const vk::Rect2D rect2D { { 0, 0 }, { _context.framebufferWidth, _context.framebufferHeight } };
+    const vk::ClearColorValue colorValue { .float32 = { { 0.0F, 0.5F, 0.0F, 1.0F } } };
+    const vk::ClearDepthStencilValue depthStencilValue { .depth = 1.F, .stencil = 0 };
+    // Draws are recorded into secondary buffers on the worker threads
+    _context.renderPass.BeginRenderPass( cmd.commandBuffer, framebuffer, rect2D, colorValue, depthStencilValue,
+                                         vk::SubpassContents::eSecondaryCommandBuffers );
+
+    return true;
+}
+
+auto VulkanRenderer::EndFrame( AppState& state ) -> bool
+{
+    auto& frame = _context.GetCurrentFrame();
+    const auto& cmd = frame.commandBuffer;
+    // const auto& framebuffer = _context.framebuffers[_context.imageIndex];
+
+    const auto inheritanceInfo = vk::CommandBufferInheritanceInfo {
+        .renderPass = _context.renderPass.GetRenderPass(),
+        .subpass = 0,
+        .framebuffer = _context.framebuffers[_context.imageIndex],
+    };
+    // Falls back to the default pipeline while the requested one is still compiling
+    const auto& pipeline = _context.pipelineManager.GetPipeline( _context.trianglePipeline );
     const auto viewportInfo = vk::Viewport { .x = 0.0F,
                                              .y = 0.0F,
                                              .width = static_cast<F32>( _context.framebufferWidth ),
                                              .height = static_cast<F32>( _context.framebufferHeight ),
                                              .minDepth = 0.0F,
                                              .maxDepth = 1.0F };
-    cmd.commandBuffer.setViewport( 0, 1, &viewportInfo );
-
     const auto scissor = vk::Rect2D {
         .offset = { 0, 0 },
         .extent = { _context.framebufferWidth, _context.framebufferHeight },
     };
-    cmd.commandBuffer.setScissor( 0, scissor );
-
-    const vk::Rect2D rect2D { { 0, 0 }, { _context.framebufferWidth, _context.framebufferHeight } };
-    const vk::ClearColorValue colorValue { .float32 = { { 0.0F, 0.5F, 0.0F, 1.0F } } };
-    const vk::ClearDepthStencilValue depthStencilValue { .depth = 1.F, .stencil = 0 };
-    _context.renderPass.BeginRenderPass( cmd.commandBuffer, framebuffer, rect2D, colorValue, depthStencilValue );
-    cmd.commandBuffer.bindPipeline( vk::PipelineBindPoint::eGraphics, _context.graphicsPipeline.GetPipeline() );
-
-    return true;
-}
+    // Colors change every frame, so they are written straight into the upload ring instead of a device local buffer
+    const auto pulse = 0.75F + 0.25F * std::sin( static_cast<F32>( _context.currentFrame ) * kColorPulseSpeed );
+    auto colors = std::pmr::vector<glm::vec3>( state.frameAllocator->GetResource() );
+    colors.reserve( triangle.size() );
+    for ( const auto& vertex : triangle )
+    {
+        colors.push_back( vertex.col * pulse );
+    }
+    const auto colorSlice = _context.uploadRing.Push( std::span<const glm::vec3>( colors ) );
 
-auto VulkanRenderer::EndFrame( [[maybe_unused]] AppState& state ) -> bool
-{
-    auto frame = _context.GetCurrentFrame();
-    const auto& cmd = _context.graphicsCommandBuffers[_context.imageIndex];
-    // const auto& framebuffer = _context.framebuffers[_context.imageIndex];
+    // Pass uniforms go through the ring too, into a set from the per-frame descriptor pools
+    const auto uniformSlice = _context.uploadRing.AllocateUniform( sizeof( PassUniforms ) );
+    auto passSet = vk::DescriptorSet {};
+    if ( uniformSlice.pData != nullptr )
+    {
+        const auto uniforms = PassUniforms {
+            .viewportSize = { static_cast<F32>( _context.framebufferWidth ),
+                              static_cast<F32>( _context.framebufferHeight ) },
+            .deltaTime = static_cast<F32>( state.deltaTime ),
+            .frameNumber = ToU32( _context.currentFrame ),
+        };
+        std::memcpy( uniformSlice.pData, &uniforms, sizeof( uniforms ) );
+        passSet = _context.descriptorAllocator.Allocate( _context.bindless.GetPassSetLayout() );
+        const auto bufferInfo = vk::DescriptorBufferInfo { .buffer = uniformSlice.buffer,
+                                                           .offset = uniformSlice.offset,
+                                                           .range = uniformSlice.size };
+        const auto write = vk::WriteDescriptorSet { .dstSet = passSet,
+                                                    .dstBinding = 0,
+                                                    .descriptorCount = 1,
+                                                    .descriptorType = vk::DescriptorType::eUniformBuffer,
+                                                    .pBufferInfo = &bufferInfo };
+        _context.GetDevice().updateDescriptorSets( write, {} );
+    }
 
-    cmd.commandBuffer.bindVertexBuffers( 0, _context.triangleBuffer.buffer, { 0 } );
-    cmd.commandBuffer.draw( ToU32( 3 ), 1, 0, 0 );
+    // One draw per triangle in the vertex buffer, none when the ring had no room for the frame data. Secondary buffers
+    // inherit nothing but the render pass, so every batch sets its own state.
+    const auto drawCount = colorSlice.pData != nullptr && passSet ? ToU32( triangle.size() / 3 ) : 0;
+    _context.parallelRecorder.Record(
+      cmd.commandBuffer, inheritanceInfo, drawCount,
+      [this, &pipeline, &viewportInfo, &scissor, &colorSlice, &passSet]( const vk::CommandBuffer& commandBuffer,
+                                                                         U32 begin, U32 end ) {
+          commandBuffer.setViewport( 0, 1, &viewportInfo );
+          commandBuffer.setScissor( 0, scissor );
+          commandBuffer.bindPipeline( vk::PipelineBindPoint::eGraphics, pipeline );
+          _context.bindless.Bind( commandBuffer, vk::PipelineBindPoint::eGraphics );
+          commandBuffer.bindDescriptorSets( vk::PipelineBindPoint::eGraphics, _context.bindless.GetPipelineLayout(),
+                                            kPassSetIndex, passSet, {} );
+          commandBuffer.bindVertexBuffers( 0, { _context.triangleBuffer.buffer, colorSlice.buffer },
+                                           { 0, colorSlice.offset } );
+          for ( auto item = begin; item < end; ++item )
+          {
+              commandBuffer.draw( 3, 1, item * 3, 0 );
+          }
+      } );
 
     _context.renderPass.EndRenderPass();
     cmd.End();
 
-    const auto dstStageMask = std::vector<vk::PipelineStageFlags> { vk::PipelineStageFlagBits::eColorAttachmentOutput };
-    const auto submitInfo = vk::SubmitInfo { .waitSemaphoreCount = 1,
-                                             .pWaitSemaphores = &frame.presentSemaphore,
+    _context.uploadRing.Flush();
+    auto waitSemaphores = std::pmr::vector<vk::Semaphore>( state.frameAllocator->GetResource() );
+    auto dstStageMask = std::pmr::vector<vk::PipelineStageFlags>( state.frameAllocator->GetResource() );
+    auto waitValues = std::pmr::vector<U64>( state.frameAllocator->GetResource() );
+    waitSemaphores.push_back( frame.presentSemaphore );
+    dstStageMask.push_back( vk::PipelineStageFlagBits::eColorAttachmentOutput );
+    waitValues.push_back( 0 );
+    if ( const auto uploadWait = _context.uploader.TakeWait() )
+    {
+        waitSemaphores.push_back( uploadWait->semaphore );
+        dstStageMask.push_back( uploadWait->stages );
+        waitValues.push_back( uploadWait->value );
+    }
+
+    // Binary semaphores ignore their value
+    const auto timelineInfo = vk::TimelineSemaphoreSubmitInfo { .waitSemaphoreValueCount = ToU32( waitValues.size() ),
+                                                                .pWaitSemaphoreValues = waitValues.data() };
+    const auto submitInfo = vk::SubmitInfo { .pNext = &timelineInfo,
+                                             .waitSemaphoreCount = ToU32( waitSemaphores.size() ),
+                                             .pWaitSemaphores = waitSemaphores.data(),
                                              .pWaitDstStageMask = dstStageMask.data(),
                                              .commandBufferCount = 1,
                                              .pCommandBuffers = &cmd.commandBuffer,
@@ -115,6 +219,7 @@ auto VulkanRenderer::EndFrame( [[maybe_unused]] AppState& state ) -> bool
         _context.RecreateFramebuffers( width, height );
         return false;
     }
+    state.FramePresented();
     WindTrace( "Presented Frame {}", _context.currentFrame );
     ++_context.currentFrame;
     return true;
@@ -1,6 +1,7 @@
 #ifndef WINDENGINE_VULKANRENDERER_HPP
 #define WINDENGINE_VULKANRENDERER_HPP
 
+#include "allocationManager.hpp"
 #include "defines.hpp"
 #include "renderer.hpp"
 #include "vulkanContext.hpp"
@@ -9,16 +10,28 @@
 namespace WindEngine::Core::Render
 {
 
+// Radians per frame of the triangle color pulse
+constexpr F32 kColorPulseSpeed = 0.05F;
+
+// Uniforms of the main render pass, bound at kPassSetIndex
+struct PassUniforms
+{
+    glm::vec2 viewportSize;
+    F32 deltaTime;
+    U32 frameNumber;
+};
+
 class VulkanRenderer final : public Renderer
 {
 public:
     auto Initialize( const AppConfig& config ) -> bool override;
     void Shutdown() override;
+    auto WaitForFrame( AppState& state ) -> bool override;
     auto BeginFrame( AppState& state ) -> bool override;
     auto EndFrame( AppState& state ) -> bool override;
     void Resize( U16 width, U16 height ) override;
 
-    VulkanRenderer() = default;
+    explicit VulkanRenderer( Memory::AllocationManager& allocationManager );
     ~VulkanRenderer() override = default;
     VulkanRenderer( const VulkanRenderer& ) = delete;
     VulkanRenderer( const VulkanRenderer&& ) = delete;
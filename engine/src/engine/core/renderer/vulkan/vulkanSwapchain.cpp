@@ -165,6 +165,7 @@ void VulkanSwapchain::Create( const vk::SurfaceKHR& surface, U32 width, U32 heig
                                                         .format = _device->depthFormat,
                                                         .imageType = vk::ImageType::e2D,
                                                         .memoryFlags = vk::MemoryPropertyFlagBits::eDeviceLocal,
+                                                        .avoidedMemoryFlags = vk::MemoryPropertyFlagBits::eHostVisible,
                                                         .tiling = vk::ImageTiling::eOptimal,
                                                         .usage = vk::ImageUsageFlagBits::eDepthStencilAttachment };
     depthImage.Initialize( depthImageInfo );
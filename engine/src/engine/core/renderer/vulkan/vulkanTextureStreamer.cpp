@@ -0,0 +1,296 @@
+#include "vulkanTextureStreamer.hpp"
+#include "assert.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace WindEngine::Core::Render
+{
+
+VulkanTextureStreamer::VulkanTextureStreamer( VulkanDevice& device, vk::AllocationCallbacks* allocator,
+                                              VulkanUploader& uploader, VulkanBindlessDescriptors& bindless,
+                                              std::pmr::memory_resource* pResource )
+  : VulkanHandle( &device, allocator ), _uploader( uploader ), _bindless( bindless ), _pResource( pResource ),
+    _textures( pResource )
+{
+}
+
+void VulkanTextureStreamer::Initialize( vk::DeviceSize budget )
+{
+    _budget = budget;
+}
+
+void VulkanTextureStreamer::Destroy()
+{
+    for ( const auto& upTexture : _textures )
+    {
+        upTexture->upImage->Destroy();
+    }
+    _textures.clear();
+    _residentBytes = 0;
+}
+
+auto VulkanTextureStreamer::Load( const std::string& path ) -> TextureHandle
+{
+    auto upTexture = std::make_unique<StreamedTexture>();
+    upTexture->path = path;
+    // Kept mapped for as long as the texture lives, streaming a level in only touches the pages it covers
+    if ( !upTexture->file.Open( path ) )
+    {
+        WindFatal( "Failed to open texture {}.", path );
+    }
+
+    const auto fileData = upTexture->file.GetData();
+    auto& header = upTexture->header;
+    if ( fileData.size() < sizeof( header ) )
+    {
+        WindFatal( "{} is not a version {} texture file.", path, kTextureFileVersion );
+    }
+    std::memcpy( &header, fileData.data(), sizeof( header ) );
+    if ( header.magic != kTextureFileMagic || header.version != kTextureFileVersion )
+    {
+        WindFatal( "{} is not a version {} texture file.", path, kTextureFileVersion );
+    }
+
+    const auto fullChain = VulkanImage::GetMipLevelCount( { header.width, header.height, 1 } );
+    if ( header.mipLevels == 0 || header.mipLevels != fullChain || header.mipLevels > kMaxTextureMipLevels )
+    {
+        WindFatal( "{} has {} mip levels, streamed textures need the full chain of {}.", path, header.mipLevels,
+                   fullChain );
+    }
+    const auto levelTableSize = sizeof( TextureFileLevel ) * header.mipLevels;
+    if ( fileData.size() < sizeof( header ) + levelTableSize )
+    {
+        WindFatal( "Failed to read the mip levels of {}.", path );
+    }
+    std::memcpy( upTexture->levels.data(), fileData.data() + sizeof( header ), levelTableSize );
+
+    // The uploader copies each level with the extent of the image, a short level would read past the staged data
+    if ( vk::blockSize( header.format ) == 0 )
+    {
+        WindFatal( "{} uses {}, which has no known block size.", path, vk::to_string( header.format ) );
+    }
+    for ( U32 ind = 0; ind < header.mipLevels; ++ind )
+    {
+        const auto expectedSize = GetLevelSize( header, ind );
+        if ( upTexture->levels[ind].size != expectedSize )
+        {
+            WindFatal( "Mip level {} of {} holds {} bytes, its format and extent need {}.", ind, path,
+                       upTexture->levels[ind].size, expectedSize );
+        }
+    }
+
+    // Streaming hands the mapped range of a whole level chain to the uploader, so the levels have to be contiguous.
+    // The first level may start anywhere after the level table.
+    for ( U32 ind = 0; ind < header.mipLevels; ++ind )
+    {
+        const auto& level = upTexture->levels[ind];
+        const auto& previous = upTexture->levels[ind == 0 ? 0 : ind - 1];
+        const auto packedOffset = ind == 0 ? std::max<U64>( level.offset, sizeof( header ) + levelTableSize )
+                                           : previous.offset + previous.size;
+        const auto isInsideFile = level.size <= fileData.size() && level.offset <= fileData.size() - level.size;
+        if ( level.offset != packedOffset || !isInsideFile )
+        {
+            WindFatal( "Mip level {} of {} is not tightly packed inside the file.", ind, path );
+        }
+    }
+
+    auto& texture = *upTexture;
+    const auto largestSide = std::max( header.width, header.height );
+    while ( texture.tailLevel + 1 < header.mipLevels && ( largestSide >> texture.tailLevel ) > kResidentTailSize )
+    {
+        ++texture.tailLevel;
+    }
+    texture.requestedLevel = texture.tailLevel;
+    texture.lastUsedFrame = _frameNumber;
+    StreamTo( texture, texture.tailLevel );
+
+    _textures.push_back( std::move( upTexture ) );
+    WindTrace( "Loaded {}, levels {} to {} are resident.", path, texture.tailLevel, header.mipLevels - 1 );
+    return ToU32( _textures.size() - 1 );
+}
+
+void VulkanTextureStreamer::ReportUsage( TextureHandle texture, F32 screenSize )
+{
+    auto& streamedTexture = *_textures.at( texture );
+    auto level = streamedTexture.tailLevel;
+    if ( screenSize > 0.0F )
+    {
+        // Each level halves the size, so the level that maps about one texel to a pixel is log2 of the ratio
+        const auto largestSide =
+          static_cast<F32>( std::max( streamedTexture.header.width, streamedTexture.header.height ) );
+        const auto texelsPerPixel = std::max( largestSide / screenSize, 1.0F );
+        level = std::min( static_cast<U32>( std::log2( texelsPerPixel ) ), streamedTexture.tailLevel );
+    }
+    streamedTexture.requestedLevel = std::min( streamedTexture.requestedLevel, level );
+    streamedTexture.lastUsedFrame = _frameNumber;
+}
+
+void VulkanTextureStreamer::Update( U64 frameNumber, VulkanDeletionQueue& deletionQueue )
+{
+    _frameNumber = frameNumber;
+    _pDeletionQueue = &deletionQueue;
+
+    // Reports arrive between updates, so they are stamped with the previous frame number
+    auto candidates = std::pmr::vector<StreamedTexture*>( _pResource );
+    for ( const auto& upTexture : _textures )
+    {
+        if ( upTexture->requestedLevel < upTexture->residentLevel && upTexture->lastUsedFrame + 1 >= frameNumber )
+        {
+            candidates.push_back( upTexture.get() );
+        }
+    }
+    std::ranges::sort( candidates, []( const StreamedTexture* pLeft, const StreamedTexture* pRight ) {
+        return pLeft->residentLevel - pLeft->requestedLevel > pRight->residentLevel - pRight->requestedLevel;
+    } );
+
+    U32 streamIns = 0;
+    for ( auto* pTexture : candidates )
+    {
+        if ( streamIns == kMaxStreamInsPerFrame )
+        {
+            break;
+        }
+        // The current image is retired by the stream in, so only the growth has to fit
+        const auto chainSize = GetLevelBytes( *pTexture, pTexture->requestedLevel );
+        const auto outgoingSize = pTexture->upImage->allocation.size;
+        const auto size = chainSize > outgoingSize ? chainSize - outgoingSize : 0;
+        if ( _residentBytes + size > _budget && !EvictFor( size ) )
+        {
+            WindDebug( "Texture budget is exhausted, {} stays at level {}.", pTexture->path, pTexture->residentLevel );
+            continue;
+        }
+        StreamTo( *pTexture, pTexture->requestedLevel );
+        ++streamIns;
+    }
+
+    for ( const auto& upTexture : _textures )
+    {
+        upTexture->requestedLevel = upTexture->tailLevel;
+    }
+    _pDeletionQueue = nullptr;
+}
+
+auto VulkanTextureStreamer::GetImage( TextureHandle texture ) const -> const VulkanImage&
+{
+    return *_textures.at( texture )->upImage;
+}
+
+auto VulkanTextureStreamer::GetResidentLevel( TextureHandle texture ) const -> U32
+{
+    return _textures.at( texture )->residentLevel;
+}
+
+auto VulkanTextureStreamer::GetBindlessIndex( TextureHandle texture ) const -> BindlessIndex
+{
+    return _textures.at( texture )->bindlessIndex;
+}
+
+void VulkanTextureStreamer::PrintStats() const
+{
+    WindDebug( "[[Texture Streaming]]" );
+    WindDebug( "\tTextures: {} - Resident: {} bytes - Budget: {} bytes - Retired Images: {}", _textures.size(),
+               _residentBytes, _budget, _retiredCount );
+    for ( const auto& upTexture : _textures )
+    {
+        WindDebug( "\t{}: Resident Level: {} - Tail Level: {} - Last Used Frame: {}", upTexture->path,
+                   upTexture->residentLevel, upTexture->tailLevel, upTexture->lastUsedFrame );
+    }
+}
+
+void VulkanTextureStreamer::StreamTo( StreamedTexture& texture, U32 level )
+{
+    const auto& header = texture.header;
+    // Load checked that the levels are packed back to back, so the chain is one range of the mapping
+    const auto chainOffset = texture.levels[level].offset;
+    const auto data = texture.file.GetData().subspan( chainOffset, GetLevelBytes( texture, level ) );
+    auto levelOffsets = std::pmr::vector<vk::DeviceSize>( _pResource );
+    for ( auto ind = level; ind < header.mipLevels; ++ind )
+    {
+        levelOffsets.push_back( texture.levels[ind].offset - chainOffset );
+    }
+
+    auto upImage = std::make_unique<VulkanImage>( *_device, _allocator );
+    upImage->Initialize( { .aspectFlags = vk::ImageAspectFlagBits::eColor,
+                           .extent = { std::max( header.width >> level, 1U ), std::max( header.height >> level, 1U ),
+                                       1 },
+                           .format = header.format,
+                           .imageType = vk::ImageType::e2D,
+                           .memoryFlags = vk::MemoryPropertyFlagBits::eDeviceLocal,
+                           .avoidedMemoryFlags = vk::MemoryPropertyFlagBits::eHostVisible,
+                           .tiling = vk::ImageTiling::eOptimal,
+                           .usage = vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst,
+                           .hasMipChain = false,
+                           .mipLevels = header.mipLevels - level } );
+    _uploader.UploadImageLevels( *upImage, data, levelOffsets, vk::PipelineStageFlagBits::eFragmentShader );
+    _residentBytes += upImage->allocation.size;
+
+    if ( texture.upImage != nullptr )
+    {
+        Retire( std::move( texture.upImage ), texture.bindlessIndex );
+    }
+    texture.bindlessIndex = _bindless.RegisterImage( upImage->imageView );
+    texture.upImage = std::move( upImage );
+    texture.residentLevel = level;
+}
+
+auto VulkanTextureStreamer::EvictFor( vk::DeviceSize size ) -> bool
+{
+    while ( _residentBytes + size > _budget )
+    {
+        // Textures used last frame are kept, dropping them would only stream them back in
+        StreamedTexture* pVictim = nullptr;
+        for ( const auto& upTexture : _textures )
+        {
+            const auto isEvictable =
+              upTexture->residentLevel < upTexture->tailLevel && upTexture->lastUsedFrame + 1 < _frameNumber;
+            if ( isEvictable && ( pVictim == nullptr || upTexture->lastUsedFrame < pVictim->lastUsedFrame ) )
+            {
+                pVictim = upTexture.get();
+            }
+        }
+        if ( pVictim == nullptr )
+        {
+            return false;
+        }
+        StreamTo( *pVictim, pVictim->tailLevel );
+        WindTrace( "Evicted {} down to its mip tail.", pVictim->path );
+    }
+    return true;
+}
+
+void VulkanTextureStreamer::Retire( std::unique_ptr<VulkanImage> upImage, BindlessIndex bindlessIndex )
+{
+    // Only Load streams outside Update, and a texture being loaded has no image to retire yet
+    WindAssert( _pDeletionQueue != nullptr, "Retiring a texture image outside of Update." );
+    _residentBytes -= upImage->allocation.size;
+    ++_retiredCount;
+    // Frames in flight keep sampling the old image through the old slot. The bindless slot defers its own reuse,
+    // the image is destroyed by the deletion queue once those frames have completed.
+    _bindless.ReleaseImage( bindlessIndex );
+    _pDeletionQueue->Push( [spImage = std::shared_ptr<VulkanImage>( std::move( upImage ) )]() { spImage->Destroy(); } );
+}
+
+auto VulkanTextureStreamer::GetLevelSize( const TextureFileHeader& header, U32 level ) -> vk::DeviceSize
+{
+    // Block compressed levels round their extent up to whole blocks
+    const auto blockExtent = vk::blockExtent( header.format );
+    const auto width = std::max( header.width >> level, 1U );
+    const auto height = std::max( header.height >> level, 1U );
+    const vk::DeviceSize blocksWide = ( width + blockExtent[0] - 1 ) / blockExtent[0];
+    const vk::DeviceSize blocksHigh = ( height + blockExtent[1] - 1 ) / blockExtent[1];
+    return blocksWide * blocksHigh * vk::blockSize( header.format );
+}
+
+auto VulkanTextureStreamer::GetLevelBytes( const StreamedTexture& texture, U32 level ) -> vk::DeviceSize
+{
+    vk::DeviceSize size = 0;
+    for ( auto ind = level; ind < texture.header.mipLevels; ++ind )
+    {
+        size += texture.levels[ind].size;
+    }
+    return size;
+}
+
+}  // namespace WindEngine::Core::Render
@@ -0,0 +1,121 @@
+#ifndef WINDENGINE_VULKANTEXTURESTREAMER_HPP
+#define WINDENGINE_VULKANTEXTURESTREAMER_HPP
+
+#include "mappedFile.hpp"
+#include "vulkanBindlessDescriptors.hpp"
+#include "vulkanFrameResources.hpp"
+#include "vulkanHandle.hpp"
+#include "vulkanImage.hpp"
+#include "vulkanUploader.hpp"
+#include <array>
+#include <memory>
+#include <memory_resource>
+#include <string>
+
+namespace WindEngine::Core::Render
+{
+
+constexpr U32 kTextureFileMagic = 0x54444E57;  // "WNDT"
+constexpr U32 kTextureFileVersion = 1;
+constexpr U32 kMaxTextureMipLevels = 16;
+// Levels this small are always resident, so a texture can be sampled as soon as it is loaded
+constexpr U32 kResidentTailSize = 64;
+constexpr vk::DeviceSize kDefaultTextureBudget = 256 * 1024 * 1024;
+// Caps the disk reads and uploads a single frame can cause
+constexpr U32 kMaxStreamInsPerFrame = 4;
+
+// A streamed texture file is this header followed by one TextureFileLevel per mip, starting at level 0, and the
+// tightly packed level data. Files hold the full chain down to 1x1.
+struct TextureFileHeader
+{
+    U32 magic {};
+    U32 version {};
+    vk::Format format {};
+    U32 width {};
+    U32 height {};
+    U32 mipLevels {};
+};
+
+struct TextureFileLevel
+{
+    // From the start of the file
+    U64 offset {};
+    U64 size {};
+};
+
+using TextureHandle = U32;
+
+struct StreamedTexture
+{
+    std::string path;
+    Memory::MappedFile file;
+    TextureFileHeader header {};
+    std::array<TextureFileLevel, kMaxTextureMipLevels> levels {};
+    // Finest level of the always resident tail
+    U32 tailLevel {};
+    // Finest level held by the current image
+    U32 residentLevel {};
+    // Finest level any usage report asked for this frame
+    U32 requestedLevel {};
+    U64 lastUsedFrame {};
+    std::unique_ptr<VulkanImage> upImage { nullptr };
+    // Slot of upImage, every residency change moves the texture to a new slot
+    BindlessIndex bindlessIndex { kInvalidBindlessIndex };
+};
+
+// Keeps the mip tail of every texture resident and streams the finer levels in from disk as usage reports ask for
+// them. A residency change reallocates the image with the new level count and uploads the levels again instead of
+// relying on sparse binding, which software implementations and many mobile drivers do not offer. When the budget
+// runs out, the least recently used textures drop back to their tail. Not thread safe.
+struct VulkanTextureStreamer : public VulkanHandle
+{
+    VulkanTextureStreamer( VulkanDevice& device, vk::AllocationCallbacks* allocator, VulkanUploader& uploader,
+                           VulkanBindlessDescriptors& bindless, std::pmr::memory_resource* pResource );
+
+    void Initialize( vk::DeviceSize budget );
+    void Destroy() override;
+
+    // Loads the mip tail, which can be sampled from the next frame the uploader submits in
+    [[nodiscard]] auto Load( const std::string& path ) -> TextureHandle;
+    // Screen-space feedback, screenSize is how many pixels the largest side of the texture covers on screen
+    void ReportUsage( TextureHandle texture, F32 screenSize );
+    // Called once per frame before the uploader submits, so the images it swaps in can be sampled in that frame.
+    // Swapped out images are destroyed through the deletion queue of that frame.
+    void Update( U64 frameNumber, VulkanDeletionQueue& deletionQueue );
+
+    [[nodiscard]] auto GetImage( TextureHandle texture ) const -> const VulkanImage&;
+    [[nodiscard]] auto GetResidentLevel( TextureHandle texture ) const -> U32;
+    // Read it every frame, the slot changes whenever the resident levels do
+    [[nodiscard]] auto GetBindlessIndex( TextureHandle texture ) const -> BindlessIndex;
+
+    [[nodiscard]] auto GetResidentBytes() const -> vk::DeviceSize
+    {
+        return _residentBytes;
+    }
+
+    void PrintStats() const;
+
+private:
+    void StreamTo( StreamedTexture& texture, U32 level );
+    [[nodiscard]] auto EvictFor( vk::DeviceSize size ) -> bool;
+    void Retire( std::unique_ptr<VulkanImage> upImage, BindlessIndex bindlessIndex );
+
+    // Size of a single level as the format and extent require it
+    [[nodiscard]] static auto GetLevelSize( const TextureFileHeader& header, U32 level ) -> vk::DeviceSize;
+    [[nodiscard]] static auto GetLevelBytes( const StreamedTexture& texture, U32 level ) -> vk::DeviceSize;
+
+    VulkanUploader& _uploader;
+    VulkanBindlessDescriptors& _bindless;
+    std::pmr::memory_resource* _pResource;
+    std::pmr::vector<std::unique_ptr<StreamedTexture>> _textures;
+    vk::DeviceSize _budget { kDefaultTextureBudget };
+    vk::DeviceSize _residentBytes {};
+    U64 _frameNumber {};
+    // Deletion queue of the frame being updated, only set during Update
+    VulkanDeletionQueue* _pDeletionQueue { nullptr };
+    U64 _retiredCount {};
+};
+
+}  // namespace WindEngine::Core::Render
+
+#endif  // WINDENGINE_VULKANTEXTURESTREAMER_HPP
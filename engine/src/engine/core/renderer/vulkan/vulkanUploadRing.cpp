@@ -0,0 +1,71 @@
+#include "vulkanUploadRing.hpp"
+#include "logger.hpp"
+#include "memoryUtils.hpp"
+#include <algorithm>
+
+namespace WindEngine::Core::Render
+{
+
+VulkanUploadRing::VulkanUploadRing( VulkanDevice& device, vk::AllocationCallbacks* allocator )
+  : VulkanHandle( &device, allocator ), _buffer( device, allocator )
+{
+}
+
+void VulkanUploadRing::Initialize( vk::DeviceSize frameSize, U32 frameCount )
+{
+    // Every region starts on an offset any kind of binding accepts
+    const auto& limits = _device->physicalDeviceInfo.properties.limits;
+    _frameSize = Memory::AlignUp( frameSize, std::max( { limits.minUniformBufferOffsetAlignment,
+                                                         limits.minStorageBufferOffsetAlignment,
+                                                         limits.nonCoherentAtomSize } ) );
+    _buffer.Initialize( { .size = _frameSize * frameCount,
+                          .usageFlags = vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer |
+                                        vk::BufferUsageFlagBits::eUniformBuffer |
+                                        vk::BufferUsageFlagBits::eStorageBuffer |
+                                        vk::BufferUsageFlagBits::eTransferSrc,
+                          .memoryFlags = vk::MemoryPropertyFlagBits::eHostVisible,
+                          .preferredMemoryFlags =
+                            vk::MemoryPropertyFlagBits::eDeviceLocal | vk::MemoryPropertyFlagBits::eHostCoherent } );
+    _frameStart = 0;
+    _offset = 0;
+}
+
+void VulkanUploadRing::Destroy()
+{
+    _buffer.Destroy();
+}
+
+void VulkanUploadRing::BeginFrame( U32 frameIndex )
+{
+    _frameStart = _frameSize * frameIndex;
+    _offset = 0;
+}
+
+void VulkanUploadRing::Flush()
+{
+    _device->memoryAllocator.Flush( _buffer.allocation, _frameStart, _offset );
+}
+
+auto VulkanUploadRing::Allocate( vk::DeviceSize size, vk::DeviceSize alignment ) -> VulkanUploadSlice
+{
+    const auto offset = Memory::AlignUp( _offset, alignment );
+    if ( offset + size > _frameSize )
+    {
+        WindError( "Upload ring is out of space. Requested {} bytes with {} of {} bytes used.", size, _offset,
+                   _frameSize );
+        return {};
+    }
+
+    _offset = offset + size;
+    return { .buffer = _buffer.buffer,
+             .offset = _frameStart + offset,
+             .size = size,
+             .pData = static_cast<std::byte*>( _buffer.pMappedData ) + _frameStart + offset };
+}
+
+auto VulkanUploadRing::AllocateUniform( vk::DeviceSize size ) -> VulkanUploadSlice
+{
+    return Allocate( size, _device->physicalDeviceInfo.properties.limits.minUniformBufferOffsetAlignment );
+}
+
+}  // namespace WindEngine::Core::Render
@@ -0,0 +1,65 @@
+#ifndef WINDENGINE_VULKANUPLOADRING_HPP
+#define WINDENGINE_VULKANUPLOADRING_HPP
+
+#include "vulkanBuffer.hpp"
+#include "vulkanHandle.hpp"
+#include <cstring>
+#include <span>
+
+namespace WindEngine::Core::Render
+{
+
+constexpr vk::DeviceSize kUploadRingFrameSize = 4 * 1024 * 1024;
+
+struct VulkanUploadSlice
+{
+    vk::Buffer buffer {};
+    vk::DeviceSize offset {};
+    vk::DeviceSize size {};
+    void* pData { nullptr };
+};
+
+// Host visible buffer split into one region per frame in flight. Per-frame vertex, index, uniform and instance data is
+// written straight into the mapped region of the current frame, and the region is handed out again once the fence of
+// that frame slot has signalled.
+struct VulkanUploadRing : public VulkanHandle
+{
+    VulkanUploadRing( VulkanDevice& device, vk::AllocationCallbacks* allocator );
+
+    void Initialize( vk::DeviceSize frameSize, U32 frameCount );
+    void Destroy() override;
+
+    // Has to be called after the fence of the frame slot was waited on
+    void BeginFrame( U32 frameIndex );
+    // Makes this frame's writes visible to the device, call before the frame is submitted
+    void Flush();
+
+    // Returns an empty slice when the frame region is full
+    [[nodiscard]] auto Allocate( vk::DeviceSize size, vk::DeviceSize alignment ) -> VulkanUploadSlice;
+    [[nodiscard]] auto AllocateUniform( vk::DeviceSize size ) -> VulkanUploadSlice;
+
+    template <typename T> auto Push( std::span<const T> data ) -> VulkanUploadSlice
+    {
+        auto slice = Allocate( data.size_bytes(), alignof( T ) );
+        if ( slice.pData != nullptr )
+        {
+            memcpy( slice.pData, data.data(), data.size_bytes() );
+        }
+        return slice;
+    }
+
+    [[nodiscard]] auto GetFrameUsage() const -> vk::DeviceSize
+    {
+        return _offset;
+    }
+
+private:
+    VulkanBuffer _buffer;
+    vk::DeviceSize _frameSize {};
+    vk::DeviceSize _frameStart {};
+    vk::DeviceSize _offset {};
+};
+
+}  // namespace WindEngine::Core::Render
+
+#endif  // WINDENGINE_VULKANUPLOADRING_HPP
@@ -0,0 +1,353 @@
+#include "vulkanUploader.hpp"
+#include "assert.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace WindEngine::Core::Render
+{
+
+static void ReleaseStagingBuffers( VulkanUploadBatch& batch )
+{
+    for ( auto& upBuffer : batch.stagingBuffers )
+    {
+        upBuffer->Destroy();
+    }
+    batch.stagingBuffers.clear();
+}
+
+VulkanUploader::VulkanUploader( VulkanDevice& device, vk::AllocationCallbacks* allocator,
+                                std::pmr::memory_resource* pResource )
+  : VulkanHandle( &device, allocator ), _pResource( pResource ), _inFlightBatches( pResource ),
+    _freeBatches( pResource ), _pendingBufferAcquires( pResource ), _pendingImageAcquires( pResource ),
+    _openBufferAcquires( pResource ), _openImageAcquires( pResource ), _pendingMipGenerations( pResource ),
+    _openMipGenerations( pResource )
+{
+}
+
+void VulkanUploader::Initialize()
+{
+    const auto poolInfo = vk::CommandPoolCreateInfo {
+        .flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer | vk::CommandPoolCreateFlagBits::eTransient,
+        .queueFamilyIndex = _device->indices.transfer,
+    };
+    _commandPool = _device->device.createCommandPool( poolInfo, _allocator );
+
+    const auto timelineInfo =
+      vk::SemaphoreTypeCreateInfo { .semaphoreType = vk::SemaphoreType::eTimeline, .initialValue = 0 };
+    _timeline = _device->device.createSemaphore( vk::SemaphoreCreateInfo { .pNext = &timelineInfo }, _allocator );
+
+    WindInfo( "Uploads use queue family {}, ownership transfers are {}.", _device->indices.transfer,
+              IsOwnershipTransferred() ? "enabled" : "not needed" );
+}
+
+void VulkanUploader::Destroy()
+{
+    const std::scoped_lock lock( _mutex );
+    if ( _upOpenBatch != nullptr )
+    {
+        ReleaseStagingBuffers( *_upOpenBatch );
+        _upOpenBatch.reset();
+    }
+    for ( auto& upBatch : _inFlightBatches )
+    {
+        ReleaseStagingBuffers( *upBatch );
+    }
+    _inFlightBatches.clear();
+    _freeBatches.clear();
+
+    // Destroying the pool frees the command buffers of all batches
+    _device->device.destroy( _commandPool, _allocator );
+    _device->device.destroy( _timeline, _allocator );
+}
+
+auto VulkanUploader::UploadBuffer( const VulkanBuffer& buffer, std::span<const std::byte> data, vk::DeviceSize offset,
+                                   vk::PipelineStageFlags dstStage, vk::AccessFlags dstAccess ) -> UploadTicket
+{
+    const std::scoped_lock lock( _mutex );
+    auto& batch = GetOpenBatch();
+    const auto& staging = CreateStagingBuffer( data );
+    const auto& cmd = batch.commandBuffer.commandBuffer;
+
+    cmd.copyBuffer( staging.buffer, buffer.buffer,
+                    vk::BufferCopy { .srcOffset = 0, .dstOffset = offset, .size = data.size() } );
+
+    if ( IsOwnershipTransferred() )
+    {
+        auto barrier = vk::BufferMemoryBarrier { .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+                                                 .dstAccessMask = {},
+                                                 .srcQueueFamilyIndex = _device->indices.transfer,
+                                                 .dstQueueFamilyIndex = _device->indices.graphics,
+                                                 .buffer = buffer.buffer,
+                                                 .offset = offset,
+                                                 .size = data.size() };
+        cmd.pipelineBarrier( vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eBottomOfPipe, {}, {},
+                             barrier, {} );
+
+        barrier.srcAccessMask = {};
+        barrier.dstAccessMask = dstAccess;
+        _openBufferAcquires.push_back( barrier );
+    }
+    _openStages |= dstStage;
+
+    return batch.ticket;
+}
+
+auto VulkanUploader::UploadImage( const VulkanImage& image, std::span<const std::byte> data,
+                                  vk::PipelineStageFlags dstStage ) -> UploadTicket
+{
+    const std::scoped_lock lock( _mutex );
+    auto& batch = GetOpenBatch();
+    const auto& staging = CreateStagingBuffer( data );
+
+    const auto region = vk::BufferImageCopy { .bufferOffset = 0,
+                                              .bufferRowLength = 0,
+                                              .bufferImageHeight = 0,
+                                              .imageSubresource = { .aspectMask = image.aspectFlags,
+                                                                    .mipLevel = 0,
+                                                                    .baseArrayLayer = 0,
+                                                                    .layerCount = 1 },
+                                              .imageOffset = {},
+                                              .imageExtent = image.extent };
+    RecordImageUpload( batch.commandBuffer.commandBuffer, image, staging, std::span( &region, 1 ),
+                       image.mipLevels > 1, dstStage );
+
+    return batch.ticket;
+}
+
+auto VulkanUploader::UploadImageLevels( const VulkanImage& image, std::span<const std::byte> data,
+                                        std::span<const vk::DeviceSize> levelOffsets, vk::PipelineStageFlags dstStage )
+  -> UploadTicket
+{
+    WindAssert( levelOffsets.size() == image.mipLevels, "Every mip level of the image needs an offset." );
+
+    const std::scoped_lock lock( _mutex );
+    auto& batch = GetOpenBatch();
+    const auto& staging = CreateStagingBuffer( data );
+
+    auto regions = std::pmr::vector<vk::BufferImageCopy>( _pResource );
+    regions.reserve( levelOffsets.size() );
+    for ( U32 level = 0; level < image.mipLevels; ++level )
+    {
+        const auto levelExtent = vk::Extent3D { std::max( image.extent.width >> level, 1U ),
+                                                std::max( image.extent.height >> level, 1U ),
+                                                std::max( image.extent.depth >> level, 1U ) };
+        regions.push_back( { .bufferOffset = levelOffsets[level],
+                             .bufferRowLength = 0,
+                             .bufferImageHeight = 0,
+                             .imageSubresource = { .aspectMask = image.aspectFlags,
+                                                   .mipLevel = level,
+                                                   .baseArrayLayer = 0,
+                                                   .layerCount = 1 },
+                             .imageOffset = {},
+                             .imageExtent = levelExtent } );
+    }
+    RecordImageUpload( batch.commandBuffer.commandBuffer, image, staging, regions, false, dstStage );
+
+    return batch.ticket;
+}
+
+void VulkanUploader::Submit()
+{
+    const std::scoped_lock lock( _mutex );
+    RecycleBatches();
+    if ( _upOpenBatch == nullptr )
+    {
+        return;
+    }
+
+    auto& batch = *_upOpenBatch;
+    batch.commandBuffer.End();
+
+    const auto timelineInfo =
+      vk::TimelineSemaphoreSubmitInfo { .signalSemaphoreValueCount = 1, .pSignalSemaphoreValues = &batch.ticket };
+    const auto submitInfo = vk::SubmitInfo { .pNext = &timelineInfo,
+                                             .commandBufferCount = 1,
+                                             .pCommandBuffers = &batch.commandBuffer.commandBuffer,
+                                             .signalSemaphoreCount = 1,
+                                             .pSignalSemaphores = &_timeline };
+    _device->transferQueue.submit( submitInfo );
+    WindTrace( "Submitted upload batch {} with {} staging buffers.", batch.ticket, batch.stagingBuffers.size() );
+
+    _pendingBufferAcquires.insert( _pendingBufferAcquires.end(), _openBufferAcquires.begin(),
+                                   _openBufferAcquires.end() );
+    _pendingImageAcquires.insert( _pendingImageAcquires.end(), _openImageAcquires.begin(), _openImageAcquires.end() );
+    _pendingMipGenerations.insert( _pendingMipGenerations.end(), _openMipGenerations.begin(),
+                                   _openMipGenerations.end() );
+    _openBufferAcquires.clear();
+    _openImageAcquires.clear();
+    _openMipGenerations.clear();
+    _pendingStages |= _openStages;
+    _openStages = {};
+    _pendingTicket = batch.ticket;
+
+    _inFlightBatches.push_back( std::move( _upOpenBatch ) );
+}
+
+void VulkanUploader::RecordAcquireBarriers( const vk::CommandBuffer& commandBuffer )
+{
+    const std::scoped_lock lock( _mutex );
+    if ( !_pendingBufferAcquires.empty() || !_pendingImageAcquires.empty() )
+    {
+        commandBuffer.pipelineBarrier( vk::PipelineStageFlagBits::eTopOfPipe, _pendingStages, {}, {},
+                                       _pendingBufferAcquires, _pendingImageAcquires );
+        _pendingBufferAcquires.clear();
+        _pendingImageAcquires.clear();
+    }
+
+    for ( const auto& mipGeneration : _pendingMipGenerations )
+    {
+        mipGeneration.pImage->RecordMipGeneration( commandBuffer, mipGeneration.dstStage );
+    }
+    _pendingMipGenerations.clear();
+}
+
+auto VulkanUploader::TakeWait() -> std::optional<UploadWait>
+{
+    const std::scoped_lock lock( _mutex );
+    if ( _pendingTicket == 0 )
+    {
+        return std::nullopt;
+    }
+
+    const auto wait = UploadWait { .semaphore = _timeline, .value = _pendingTicket, .stages = _pendingStages };
+    _pendingTicket = 0;
+    _pendingStages = {};
+    return wait;
+}
+
+auto VulkanUploader::IsComplete( UploadTicket ticket ) const -> bool
+{
+    return _device->device.getSemaphoreCounterValue( _timeline ) >= ticket;
+}
+
+void VulkanUploader::Wait( UploadTicket ticket )
+{
+    {
+        const std::scoped_lock lock( _mutex );
+        WindAssert( _upOpenBatch == nullptr || ticket < _upOpenBatch->ticket,
+                    "The upload has not been submitted yet, waiting on it would never return." );
+    }
+
+    const auto waitInfo = vk::SemaphoreWaitInfo { .semaphoreCount = 1, .pSemaphores = &_timeline, .pValues = &ticket };
+    if ( _device->device.waitSemaphores( waitInfo, std::numeric_limits<U64>::max() ) != vk::Result::eSuccess )
+    {
+        WindError( "Failed to wait for upload {}.", ticket );
+    }
+}
+
+void VulkanUploader::RecordImageUpload( const vk::CommandBuffer& cmd, const VulkanImage& image,
+                                        const VulkanBuffer& staging, std::span<const vk::BufferImageCopy> regions,
+                                        bool generateMips, vk::PipelineStageFlags dstStage )
+{
+    // Transfer queues can not blit, so the lower levels are generated on the graphics queue after the acquire
+    const auto subresourceRange = vk::ImageSubresourceRange { .aspectMask = image.aspectFlags,
+                                                              .baseMipLevel = 0,
+                                                              .levelCount = image.mipLevels,
+                                                              .baseArrayLayer = 0,
+                                                              .layerCount = 1 };
+    const auto toTransfer = vk::ImageMemoryBarrier { .srcAccessMask = {},
+                                                     .dstAccessMask = vk::AccessFlagBits::eTransferWrite,
+                                                     .oldLayout = vk::ImageLayout::eUndefined,
+                                                     .newLayout = vk::ImageLayout::eTransferDstOptimal,
+                                                     .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                                                     .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                                                     .image = image.image,
+                                                     .subresourceRange = subresourceRange };
+    cmd.pipelineBarrier( vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer, {}, {}, {},
+                         toTransfer );
+
+    cmd.copyBufferToImage( staging.buffer, image.image, vk::ImageLayout::eTransferDstOptimal, regions );
+
+    // Without an ownership transfer the layout change is made visible by the semaphore the graphics submit waits on
+    auto release = vk::ImageMemoryBarrier { .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+                                            .dstAccessMask = {},
+                                            .oldLayout = vk::ImageLayout::eTransferDstOptimal,
+                                            .newLayout = generateMips ? vk::ImageLayout::eTransferDstOptimal
+                                                                      : vk::ImageLayout::eShaderReadOnlyOptimal,
+                                            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                                            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                                            .image = image.image,
+                                            .subresourceRange = subresourceRange };
+    if ( IsOwnershipTransferred() )
+    {
+        release.srcQueueFamilyIndex = _device->indices.transfer;
+        release.dstQueueFamilyIndex = _device->indices.graphics;
+    }
+    cmd.pipelineBarrier( vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eBottomOfPipe, {}, {}, {},
+                         release );
+
+    if ( IsOwnershipTransferred() )
+    {
+        release.srcAccessMask = {};
+        release.dstAccessMask = generateMips ? vk::AccessFlagBits::eTransferRead | vk::AccessFlagBits::eTransferWrite
+                                             : vk::AccessFlagBits::eShaderRead;
+        _openImageAcquires.push_back( release );
+    }
+    if ( generateMips )
+    {
+        _openMipGenerations.push_back( { .pImage = &image, .dstStage = dstStage } );
+        _openStages |= vk::PipelineStageFlagBits::eTransfer;
+    }
+    _openStages |= dstStage;
+}
+
+auto VulkanUploader::GetOpenBatch() -> VulkanUploadBatch&
+{
+    if ( _upOpenBatch != nullptr )
+    {
+        return *_upOpenBatch;
+    }
+
+    if ( _freeBatches.empty() )
+    {
+        _upOpenBatch = std::make_unique<VulkanUploadBatch>(
+          VulkanUploadBatch { .commandBuffer = {},
+                              .ticket = 0,
+                              .stagingBuffers = std::pmr::vector<std::unique_ptr<VulkanBuffer>>( _pResource ) } );
+        _upOpenBatch->commandBuffer.Allocate( _device->device, _commandPool, true );
+    }
+    else
+    {
+        _upOpenBatch = std::move( _freeBatches.back() );
+        _freeBatches.pop_back();
+    }
+
+    _upOpenBatch->ticket = _nextTicket++;
+    _upOpenBatch->commandBuffer.Begin();
+    return *_upOpenBatch;
+}
+
+auto VulkanUploader::CreateStagingBuffer( std::span<const std::byte> data ) -> const VulkanBuffer&
+{
+    auto upBuffer = std::make_unique<VulkanBuffer>( *_device, _allocator );
+    upBuffer->Initialize( { .size = data.size(),
+                            .usageFlags = vk::BufferUsageFlagBits::eTransferSrc,
+                            .memoryFlags = vk::MemoryPropertyFlagBits::eHostVisible,
+                            .preferredMemoryFlags = vk::MemoryPropertyFlagBits::eHostCoherent,
+                            .avoidedMemoryFlags = vk::MemoryPropertyFlagBits::eDeviceLocal } );
+    upBuffer->WriteMemory( data );
+    return *_upOpenBatch->stagingBuffers.emplace_back( std::move( upBuffer ) );
+}
+
+auto VulkanUploader::IsOwnershipTransferred() const -> bool
+{
+    return _device->indices.transfer != _device->indices.graphics;
+}
+
+void VulkanUploader::RecycleBatches()
+{
+    const auto completedTicket = _device->device.getSemaphoreCounterValue( _timeline );
+    for ( auto& upBatch : _inFlightBatches )
+    {
+        if ( upBatch->ticket <= completedTicket )
+        {
+            ReleaseStagingBuffers( *upBatch );
+            upBatch->commandBuffer.Reset();
+            _freeBatches.push_back( std::move( upBatch ) );
+        }
+    }
+    std::erase( _inFlightBatches, nullptr );
+}
+
+}  // namespace WindEngine::Core::Render
@@ -0,0 +1,106 @@
+#ifndef WINDENGINE_VULKANUPLOADER_HPP
+#define WINDENGINE_VULKANUPLOADER_HPP
+
+#include "vulkanBuffer.hpp"
+#include "vulkanCommandBuffer.hpp"
+#include "vulkanHandle.hpp"
+#include "vulkanImage.hpp"
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <span>
+
+namespace WindEngine::Core::Render
+{
+
+// Value the upload timeline semaphore reaches once the batch holding the upload has finished
+using UploadTicket = U64;
+
+struct UploadWait
+{
+    vk::Semaphore semaphore {};
+    U64 value {};
+    vk::PipelineStageFlags stages {};
+};
+
+struct VulkanMipGeneration
+{
+    const VulkanImage* pImage { nullptr };
+    vk::PipelineStageFlags dstStage {};
+};
+
+struct VulkanUploadBatch
+{
+    VulkanCommandBuffer commandBuffer {};
+    UploadTicket ticket {};
+    std::pmr::vector<std::unique_ptr<VulkanBuffer>> stagingBuffers;
+};
+
+// Copies data into device local buffers and images on the transfer queue. Uploads are recorded into an open batch
+// and Submit sends the batch off once per frame, signalling a timeline semaphore with the batch ticket. The graphics
+// submit of that frame waits on the ticket, and when the transfer queue is of another family the graphics command
+// buffer acquires ownership of the uploaded resources first.
+struct VulkanUploader : public VulkanHandle
+{
+    VulkanUploader( VulkanDevice& device, vk::AllocationCallbacks* allocator, std::pmr::memory_resource* pResource );
+
+    void Initialize();
+    void Destroy() override;
+
+    auto UploadBuffer( const VulkanBuffer& buffer, std::span<const std::byte> data, vk::DeviceSize offset,
+                       vk::PipelineStageFlags dstStage, vk::AccessFlags dstAccess ) -> UploadTicket;
+    // Uploads the first mip level, the image ends up in eShaderReadOnlyOptimal. Images with a mip chain get their lower
+    // levels generated in the graphics command buffer of RecordAcquireBarriers, so they have to outlive that frame.
+    auto UploadImage( const VulkanImage& image, std::span<const std::byte> data, vk::PipelineStageFlags dstStage )
+      -> UploadTicket;
+    // Uploads every mip level of the image from data, levelOffsets holds the offset of each level starting at level 0
+    auto UploadImageLevels( const VulkanImage& image, std::span<const std::byte> data,
+                            std::span<const vk::DeviceSize> levelOffsets, vk::PipelineStageFlags dstStage )
+      -> UploadTicket;
+
+    // Submits the open batch and recycles the batches the device has finished
+    void Submit();
+    // Has to be recorded into the graphics command buffer that is submitted with TakeWait, before any use and outside
+    // of a render pass
+    void RecordAcquireBarriers( const vk::CommandBuffer& commandBuffer );
+    [[nodiscard]] auto TakeWait() -> std::optional<UploadWait>;
+
+    [[nodiscard]] auto IsComplete( UploadTicket ticket ) const -> bool;
+    void Wait( UploadTicket ticket );
+
+private:
+    [[nodiscard]] auto GetOpenBatch() -> VulkanUploadBatch&;
+    void RecordImageUpload( const vk::CommandBuffer& cmd, const VulkanImage& image, const VulkanBuffer& staging,
+                            std::span<const vk::BufferImageCopy> regions, bool generateMips,
+                            vk::PipelineStageFlags dstStage );
+    [[nodiscard]] auto CreateStagingBuffer( std::span<const std::byte> data ) -> const VulkanBuffer&;
+    [[nodiscard]] auto IsOwnershipTransferred() const -> bool;
+    void RecycleBatches();
+
+    std::pmr::memory_resource* _pResource;
+    vk::CommandPool _commandPool {};
+    vk::Semaphore _timeline {};
+    UploadTicket _nextTicket { 1 };
+
+    std::unique_ptr<VulkanUploadBatch> _upOpenBatch { nullptr };
+    std::pmr::vector<std::unique_ptr<VulkanUploadBatch>> _inFlightBatches;
+    std::pmr::vector<std::unique_ptr<VulkanUploadBatch>> _freeBatches;
+
+    // Acquire side of the batches submitted since the last graphics submit
+    std::pmr::vector<vk::BufferMemoryBarrier> _pendingBufferAcquires;
+    std::pmr::vector<vk::ImageMemoryBarrier> _pendingImageAcquires;
+    std::pmr::vector<vk::BufferMemoryBarrier> _openBufferAcquires;
+    std::pmr::vector<vk::ImageMemoryBarrier> _openImageAcquires;
+    std::pmr::vector<VulkanMipGeneration> _pendingMipGenerations;
+    std::pmr::vector<VulkanMipGeneration> _openMipGenerations;
+    vk::PipelineStageFlags _pendingStages {};
+    vk::PipelineStageFlags _openStages {};
+    UploadTicket _pendingTicket { 0 };
+
+    mutable std::mutex _mutex;
+};
+
+}  // namespace WindEngine::Core::Render
+
+#endif  // WINDENGINE_VULKANUPLOADER_HPP
@@ -0,0 +1,86 @@
+#include "threadPool.hpp"
+#include "logger.hpp"
+#include <algorithm>
+
+namespace WindEngine::Core
+{
+
+static thread_local U32 tWorkerIndex = kInvalidWorkerIndex;
+
+ThreadPool::ThreadPool( U32 threadCount )
+{
+    _workers.reserve( std::max( threadCount, 1U ) );
+    for ( U32 ind = 0; ind < std::max( threadCount, 1U ); ++ind )
+    {
+        _workers.emplace_back( [this, ind]( const std::stop_token& stopToken ) {
+            tWorkerIndex = ind;
+            WorkerLoop( stopToken );
+        } );
+    }
+    WindInfo( "Started {} worker threads.", _workers.size() );
+}
+
+ThreadPool::~ThreadPool()
+{
+    for ( auto& worker : _workers )
+    {
+        worker.request_stop();
+    }
+    _taskAvailable.notify_all();
+    // Joined here rather than by the member destructor, the workers still use the mutex and queues
+    _workers.clear();
+}
+
+void ThreadPool::Submit( std::function<void()> task )
+{
+    {
+        const auto lock = std::scoped_lock( _mutex );
+        _tasks.push_back( std::move( task ) );
+    }
+    _taskAvailable.notify_one();
+}
+
+void ThreadPool::WaitIdle()
+{
+    auto lock = std::unique_lock( _mutex );
+    _idle.wait( lock, [this]() { return _tasks.empty() && _runningCount == 0; } );
+}
+
+auto ThreadPool::GetWorkerIndex() -> U32
+{
+    return tWorkerIndex;
+}
+
+auto ThreadPool::GetDefaultThreadCount() -> U32
+{
+    const auto hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+}
+
+void ThreadPool::WorkerLoop( const std::stop_token& stopToken )
+{
+    auto lock = std::unique_lock( _mutex );
+    while ( true )
+    {
+        // Returns false only once stop was requested and the queue is drained
+        if ( !_taskAvailable.wait( lock, stopToken, [this]() { return !_tasks.empty(); } ) )
+        {
+            return;
+        }
+        auto task = std::move( _tasks.front() );
+        _tasks.pop_front();
+        ++_runningCount;
+
+        lock.unlock();
+        task();
+        lock.lock();
+
+        --_runningCount;
+        if ( _tasks.empty() && _runningCount == 0 )
+        {
+            _idle.notify_all();
+        }
+    }
+}
+
+}  // namespace WindEngine::Core
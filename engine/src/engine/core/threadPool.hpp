@@ -0,0 +1,60 @@
+#ifndef WINDENGINE_THREADPOOL_HPP
+#define WINDENGINE_THREADPOOL_HPP
+
+#include "defines.hpp"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace WindEngine::Core
+{
+
+constexpr U32 kInvalidWorkerIndex = UINT32_MAX;
+
+// Fixed set of worker threads draining one FIFO queue. Tasks must not throw, whatever is queued when the pool is
+// destroyed still runs before the workers exit.
+class ThreadPool
+{
+public:
+    explicit ThreadPool( U32 threadCount = GetDefaultThreadCount() );
+    ~ThreadPool();
+
+    ThreadPool( const ThreadPool& ) = delete;
+    ThreadPool( ThreadPool&& ) = delete;
+    auto operator=( const ThreadPool& ) -> ThreadPool& = delete;
+    auto operator=( ThreadPool&& ) -> ThreadPool& = delete;
+
+    void Submit( std::function<void()> task );
+    // Blocks until the queue is empty and no task is running
+    void WaitIdle();
+
+    [[nodiscard]] auto GetThreadCount() const -> U32
+    {
+        return static_cast<U32>( _workers.size() );
+    }
+
+    // Index of the calling thread within its pool, kInvalidWorkerIndex on threads no pool started. Lets callers keep
+    // per-thread state such as command pools in a flat array.
+    [[nodiscard]] static auto GetWorkerIndex() -> U32;
+
+    // Leaves one hardware thread for the main loop
+    [[nodiscard]] static auto GetDefaultThreadCount() -> U32;
+
+private:
+    void WorkerLoop( const std::stop_token& stopToken );
+
+    std::mutex _mutex;
+    std::condition_variable_any _taskAvailable;
+    std::condition_variable _idle;
+    std::deque<std::function<void()>> _tasks;
+    U32 _runningCount {};
+    std::vector<std::jthread> _workers;
+};
+
+}  // namespace WindEngine::Core
+
+#endif  // WINDENGINE_THREADPOOL_HPP
@@ -12,12 +12,12 @@ using namespace WindEngine::Core;
 using namespace WindEngine::Core::Memory;
 using namespace WindEngine::Core::Render;
 
-auto CreateRenderer( RendererTypes type ) -> std::unique_ptr<Renderer>
+auto CreateRenderer( RendererTypes type, AllocationManager& allocationManager ) -> std::unique_ptr<Renderer>
 {
     switch ( type )
     {
     case RendererTypes::VULKAN:
-        return std::make_unique<VulkanRenderer>();
+        return std::make_unique<VulkanRenderer>( allocationManager );
     case RendererTypes::DIRECTX:
         WindError( "DIRECTX renderer not implemented." );
         return nullptr;
@@ -27,7 +27,11 @@ auto CreateRenderer( RendererTypes type ) -> std::unique_ptr<Renderer>
 
 Engine::Engine( std::unique_ptr<App> app )
   : _upApp( std::move( app ) ), _spAppState( std::make_shared<AppState>() ),
-    _upRenderer( CreateRenderer( kDefaultRenderer ) )
+    _config( _upApp->GetConfig() ),
+    // Update and Render run before the fence wait, so the CPU frame is one ahead of the frames in flight. Its arena
+    // was last used framesInFlight + 1 frames ago, and the waits since then guarantee the GPU finished that frame.
+    _frameAllocator( kDefaultFrameArenaSize, _config.framesInFlight + 1, { .useHugePages = true } ),
+    _upRenderer( CreateRenderer( kDefaultRenderer, _allocationManager ) )
 {
     if ( Initialize() )
     {
@@ -49,9 +53,14 @@ auto Engine::Initialize() -> bool
         return false;
     }
 
-    // TODO(emreaydn): Hard-coded
-    const AppConfig config( "WindEngine", 1600, 900 );
-    if ( !_upRenderer->Initialize( config ) )
+    _frameAllocator.Init();
+    _spAppState->frameAllocator = &_frameAllocator;
+    for ( size_t ind = 0; ind != _frameAllocator.GetArenaCount(); ++ind )
+    {
+        _allocationManager.RegisterArena( fmt::format( "Frame Arena {}", ind ), _frameAllocator.GetArena( ind ) );
+    }
+
+    if ( !_upRenderer->Initialize( _config ) )
     {
         return false;
     }
@@ -69,7 +78,12 @@ void Engine::Run()
     }
     while ( _spAppState->isRunning )
     {
+        // Low latency mode blocks on the frame fence before sampling input, so input is fresh when the frame is
+        // recorded. The default mode blocks after Update and Render instead, which overlaps the app work with the
+        // GPU at the cost of input that is older by the time of the wait.
+        auto isFrameReady = _config.lowLatency && _upRenderer->WaitForFrame( *_spAppState );
         _window.PollEvents( *_spAppState );
+        _spAppState->InputSampled();
 
         if ( _spAppState->isSuspended )
         {
@@ -78,15 +92,23 @@ void Engine::Run()
 
         _spAppState->FrameStart();
 
-        //        _upApp->Update();
-        //        _upApp->Render();
+        _upApp->Update( *_spAppState );
+        _upApp->Render( *_spAppState );
 
-        if ( _upRenderer->BeginFrame( *_spAppState ) )
+        if ( !_config.lowLatency )
+        {
+            isFrameReady = _upRenderer->WaitForFrame( *_spAppState );
+        }
+        if ( isFrameReady && _upRenderer->BeginFrame( *_spAppState ) )
         {
             _upRenderer->EndFrame( *_spAppState );
         }
 
         _spAppState->FrameEnd();
+
+        const auto memoryDelta = _allocationManager.CaptureFrameDelta();
+        WindTrace( "Frame Memory: {} allocations - {} frees - {} bytes", memoryDelta.total.allocations,
+                   memoryDelta.total.frees, memoryDelta.total.bytes );
     }
 }
 
@@ -100,6 +122,23 @@ void Engine::Shutdown()
 
     _upRenderer->Shutdown();
 
+    const auto& stats = _spAppState->frameStats;
+    if ( stats.presentedFrames != 0 )
+    {
+        WindDebug( "{} frames in flight{} - Average Input to Present: {:.3f} ms - Average Fence Wait: {:.3f} ms",
+                   _config.framesInFlight, _config.lowLatency ? " (low latency)" : "",
+                   stats.totalInputToPresent / static_cast<F64>( stats.presentedFrames ),
+                   stats.totalFenceWait / static_cast<F64>( stats.presentedFrames ) );
+    }
+
+    WindDebug( "Frame arena high-water mark: {} bytes", _frameAllocator.GetHighWaterMark() );
+    _allocationManager.PrintStats();
+    for ( size_t ind = 0; ind != _frameAllocator.GetArenaCount(); ++ind )
+    {
+        _allocationManager.UnregisterArena( _frameAllocator.GetArena( ind ) );
+    }
+    _spAppState->frameAllocator = nullptr;
+
     SDL_Quit();
 }
 
@@ -2,7 +2,9 @@
 #define WINDENGINE_ENGINE_HPP
 
 #include "allocationManager.hpp"
+#include "appConfig.h"
 #include "defines.hpp"
+#include "frameAllocator.hpp"
 #include "renderer.hpp"
 #include "window.hpp"
 #include <memory>
@@ -32,6 +34,8 @@ private:
     std::shared_ptr<AppState> _spAppState { nullptr };
     Core::Window _window {};
     Core::Memory::AllocationManager _allocationManager {};
+    AppConfig _config;
+    Core::Memory::FrameAllocator _frameAllocator;
     std::unique_ptr<Core::Render::Renderer> _upRenderer { nullptr };
 };
 }  // namespace WindEngine
@@ -3,7 +3,6 @@
 
 #include "app.hpp"
 #include "core/logger.hpp"
-#include "core/memory/linearAllocator.hpp"
 #include "engine.hpp"
 
 auto G_CREATE_APP() -> std::unique_ptr<WindEngine::App>;
@@ -12,9 +11,6 @@ auto main() -> int
 {
     WindEngine::Core::Logger::Initialize();
 
-    WindEngine::Core::Memory::LinearAllocator allocator { 256 };
-    allocator.Init();
-
     {
         WindEngine::Engine engine { G_CREATE_APP() };
         engine.Run();
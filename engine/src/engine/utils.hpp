@@ -3,33 +3,30 @@
 
 #include "defines.hpp"
 #include "logger.hpp"
-#include <filesystem>
-#include <fstream>
-#include <set>
+#include <algorithm>
+#include <functional>
+#include <span>
 
 namespace WindEngine
 {
 
-template <typename T> auto G_READ_SHADER_FROM_FILE( const std::string& fileName ) -> std::vector<T>
+// Same mixing as boost::hash_combine
+template <typename T> void G_HASH_COMBINE( size_t& seed, const T& value )
 {
-    const auto filePath = std::filesystem::current_path().append( fileName );
-    std::fstream file { filePath, std::ios::binary | std::ios::in | std::ios::ate };
-    if ( !file.is_open() )
-    {
-        throw std::runtime_error( "Failed to open file" );
-    }
-    const auto size = file.tellg();
-    file.seekg( 0, std::ios::beg );
-
-    std::vector<T> out( size );
-    file.read( reinterpret_cast<char*>( out.data() ), size );
-    return out;
+    seed ^= std::hash<T> {}( value ) + 0x9E3779B97F4A7C15ULL + ( seed << 6U ) + ( seed >> 2U );
 }
 
-template <typename T> auto G_IS_VECTOR_UNIQUE( const std::vector<T>& vec ) -> bool
+// Meant for short lists such as queue family indices, so it does not allocate
+template <typename T> auto G_ARE_VALUES_UNIQUE( std::span<const T> values ) -> bool
 {
-    std::set<T> set( vec.begin(), vec.end() );
-    return set.size() == vec.size();
+    for ( size_t ind = 0; ind < values.size(); ++ind )
+    {
+        if ( std::find( values.begin() + ind + 1, values.end(), values[ind] ) != values.end() )
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 }  // namespace WindEngine
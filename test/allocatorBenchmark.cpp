@@ -0,0 +1,123 @@
+#include <engine/core/logger.hpp>
+#include <engine/core/memory/cAllocator.hpp>
+#include <engine/core/memory/poolAllocator.hpp>
+#include <engine/core/memory/sizeClassAllocator.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace WindEngine::Core::Memory;
+
+namespace
+{
+
+constexpr size_t kLiveCount = 16 * 1024;
+constexpr size_t kRounds = 64;
+constexpr std::array<size_t, 4> kSlotSizes { 16, 64, 256, 1024 };
+
+// Written after each run so the compiler can not drop the allocations
+volatile size_t gSink {};
+
+// Allocates kLiveCount blocks and frees them in allocation order, the pattern of per frame scratch objects
+auto BenchmarkBulk( Allocator& allocator, size_t size ) -> double
+{
+    std::vector<void*> blocks( kLiveCount );
+    const auto start = std::chrono::steady_clock::now();
+    for ( size_t round = 0; round < kRounds; ++round )
+    {
+        for ( auto& block : blocks )
+        {
+            block = allocator.Allocate( size, kDefaultAlignment );
+            std::memset( block, 0, sizeof( size_t ) );
+        }
+        for ( auto* block : blocks )
+        {
+            allocator.Free( block );
+        }
+    }
+    const auto elapsed = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start );
+    gSink = gSink + reinterpret_cast<size_t>( blocks.back() );
+    return elapsed.count();
+}
+
+// Keeps kLiveCount blocks alive and replaces them in a shuffled order, which scatters the free lists
+auto BenchmarkChurn( Allocator& allocator, size_t size ) -> double
+{
+    std::vector<void*> blocks( kLiveCount );
+    std::vector<size_t> order( kLiveCount );
+    for ( size_t ind = 0; ind < kLiveCount; ++ind )
+    {
+        order[ind] = ind;
+    }
+    std::shuffle( order.begin(), order.end(), std::mt19937 { 42 } );
+
+    for ( auto& block : blocks )
+    {
+        block = allocator.Allocate( size, kDefaultAlignment );
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for ( size_t round = 0; round < kRounds; ++round )
+    {
+        for ( const auto ind : order )
+        {
+            allocator.Free( blocks[ind] );
+            blocks[ind] = allocator.Allocate( size, kDefaultAlignment );
+            std::memset( blocks[ind], 0, sizeof( size_t ) );
+        }
+    }
+    const auto elapsed = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start );
+    for ( auto* block : blocks )
+    {
+        gSink = gSink + reinterpret_cast<size_t>( block );
+        allocator.Free( block );
+    }
+    return elapsed.count();
+}
+
+void Report( const char* name, size_t size, double bulkMs, double churnMs, double baseBulkMs, double baseChurnMs )
+{
+    constexpr double kOperations = 2.0 * kLiveCount * kRounds;
+    WindInfo( "\t{:<10} {:>5} B  bulk {:>7.2f} ms ({:>5.1f} ns/op, x{:.2f})"
+              "  churn {:>7.2f} ms ({:>5.1f} ns/op, x{:.2f})",
+              name, size, bulkMs, bulkMs * 1e6 / kOperations, baseBulkMs / bulkMs, churnMs,
+              churnMs * 1e6 / kOperations, baseChurnMs / churnMs );
+}
+
+}  // namespace
+
+// Compares the pool and size class allocators against the C allocator for same size allocations
+auto main() -> int
+{
+    WindEngine::Core::Logger::Initialize();
+    // Pool growth is traced per block, which would drown the results
+    WIND_GET_LOGGER->set_level( spdlog::level::info );
+    WindInfo( "[[Allocator Benchmark]] {} live blocks, {} rounds, speedup relative to CAllocator", kLiveCount,
+              kRounds );
+
+    for ( const auto size : kSlotSizes )
+    {
+        CAllocator cAllocator;
+        cAllocator.Init();
+        const auto cBulk = BenchmarkBulk( cAllocator, size );
+        const auto cChurn = BenchmarkChurn( cAllocator, size );
+        Report( "CAllocator", size, cBulk, cChurn, cBulk, cChurn );
+
+        PoolAllocator pool( size );
+        pool.Init();
+        const auto poolBulk = BenchmarkBulk( pool, size );
+        const auto poolChurn = BenchmarkChurn( pool, size );
+        Report( "Pool", size, poolBulk, poolChurn, cBulk, cChurn );
+
+        SizeClassAllocator sizeClass;
+        sizeClass.Init();
+        const auto sizeClassBulk = BenchmarkBulk( sizeClass, size );
+        const auto sizeClassChurn = BenchmarkChurn( sizeClass, size );
+        Report( "SizeClass", size, sizeClassBulk, sizeClassChurn, cBulk, cChurn );
+    }
+
+    WindEngine::Core::Logger::Shutdown();
+    return 0;
+}
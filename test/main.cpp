@@ -1,4 +1,5 @@
 #include <engine/app.hpp>
+#include <engine/appState.hpp>
 #include <engine/core/logger.hpp>
 #include <engine/main.hpp>
 #include <memory>
@@ -19,13 +20,13 @@ public:
         WindDebug( "WindEditorApp::Shutdown." );
     }
 
-    void Update() override
+    void Update( [[maybe_unused]] AppState& state ) override
     {
         SDL_Delay( 3 );
         //        WindTrace( "WindEditorApp::Update." );
     }
 
-    void Render() override
+    void Render( [[maybe_unused]] AppState& state ) override
     {
         SDL_Delay( 3 );
         //        WindTrace( "WindEditorApp::Render." );
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+"""Writes streamed texture files (.wtex) read by VulkanTextureStreamer::Load.
+
+Layout, little endian, matching vulkanTextureStreamer.hpp:
+  TextureFileHeader  magic, version, format (VkFormat), width, height, mipLevels as uint32
+  TextureFileLevel   offset, size as uint64, one per mip level starting at level 0
+  level data         tightly packed, level 0 first, down to 1x1
+
+Usage:
+  textures/generate.py                                 regenerates textures/checker.wtex
+  textures/generate.py out.wtex --size 256x128 --format bc1
+  textures/generate.py bad.wtex --truncate-level 3     writes a level one byte short, Load has to reject it
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = 0x54444E57  # "WNDT"
+VERSION = 1
+
+# VkFormat value, bytes per block, block width, block height
+FORMATS = {
+    "r8": (9, 1, 1, 1),
+    "rgba8": (37, 4, 1, 1),
+    "rgba8_srgb": (43, 4, 1, 1),
+    "bc1": (133, 8, 4, 4),
+    "bc7": (145, 16, 4, 4),
+}
+
+
+def level_extent(width, height, level):
+    return max(width >> level, 1), max(height >> level, 1)
+
+
+def checker_level(width, height, texel_size):
+    # Eight squares across at every level, levels below 8 texels fade to flat white
+    data = bytearray()
+    for y in range(height):
+        for x in range(width):
+            is_light = width < 8 or ((x * 8 // width) + (y * 8 // height)) % 2 == 0
+            value = 255 if is_light else 64
+            data += bytes([value] * min(texel_size, 3)) + bytes([255] * (texel_size - 3))
+    return bytes(data)
+
+
+def level_data(fmt, width, height):
+    _, block_size, block_width, block_height = FORMATS[fmt]
+    if block_width == 1:
+        return checker_level(width, height, block_size)
+    # Compressed levels are zero filled, they exist to exercise the size checks rather than to look like anything
+    blocks = ((width + block_width - 1) // block_width) * ((height + block_height - 1) // block_height)
+    return bytes(blocks * block_size)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Write a streamed texture file.")
+    parser.add_argument("output", nargs="?", default=os.path.join(os.path.dirname(__file__), "checker.wtex"))
+    parser.add_argument("--size", default="128x128", help="WIDTHxHEIGHT of level 0")
+    parser.add_argument("--format", default="rgba8", choices=sorted(FORMATS))
+    parser.add_argument("--truncate-level", type=int, help="store this level one byte short")
+    args = parser.parse_args()
+
+    width, height = (int(side) for side in args.size.lower().split("x"))
+    mip_levels = max(width, height).bit_length()
+    header_size = struct.calcsize("<6I")
+    data_offset = header_size + struct.calcsize("<2Q") * mip_levels
+
+    levels = []
+    data = bytearray()
+    for level in range(mip_levels):
+        payload = level_data(args.format, *level_extent(width, height, level))
+        if level == args.truncate_level:
+            payload = payload[:-1]
+        levels.append((data_offset + len(data), len(payload)))
+        data += payload
+
+    with open(args.output, "wb") as file:
+        file.write(struct.pack("<6I", MAGIC, VERSION, FORMATS[args.format][0], width, height, mip_levels))
+        for offset, size in levels:
+            file.write(struct.pack("<2Q", offset, size))
+        file.write(data)
+    print(f"Wrote {args.output}: {width}x{height} {args.format}, {mip_levels} levels, {len(data)} bytes of texels")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())